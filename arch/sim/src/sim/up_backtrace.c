@@ -0,0 +1,107 @@
+/****************************************************************************
+ * arch/sim/src/sim/up_backtrace.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/arch.h>
+
+#include "sched/sched.h"
+#include "up_internal.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_backtrace
+ *
+ * Description:
+ *  up_backtrace()  returns  a backtrace for the TCB, in the array
+ *  pointed to by buffer.  A backtrace is the series of currently active
+ *  function calls for the program.  Each item in the array pointed to by
+ *  buffer is of type void *, and is the return address from the
+ *  corresponding stack frame.  The size argument specifies the maximum
+ *  number of addresses that can be stored in buffer.   If  the backtrace is
+ *  larger than size, then the addresses corresponding to the size most
+ *  recent function calls are returned; to obtain the complete backtrace,
+ *  make sure that buffer and size are large enough.
+ *
+ *  The simulation uses the unwinder of the host, which can only walk the
+ *  stack it is running on.  No backtrace is returned for a thread other
+ *  than the running one.
+ *
+ * Input Parameters:
+ *   tcb    - Address of the task's TCB, NULL means dump the running task
+ *   buffer - Return address from the corresponding stack frame
+ *   size   - Maximum number of addresses that can be stored in buffer
+ *
+ * Returned Value:
+ *   up_backtrace() returns the number of addresses returned in buffer
+ *
+ ****************************************************************************/
+
+int up_backtrace(FAR struct tcb_s *tcb, FAR void **buffer, int size)
+{
+  if (size <= 0 || buffer == NULL)
+    {
+      return 0;
+    }
+
+  if (tcb != NULL && tcb != running_task())
+    {
+      return 0;
+    }
+
+  return host_backtrace(buffer, size);
+}
+
+/****************************************************************************
+ * Name: up_interrupted_backtrace
+ *
+ * Description:
+ *  up_interrupted_backtrace() returns a backtrace of the context that was
+ *  interrupted by the simulated interrupt that is currently being handled,
+ *  without the frames of the host signal handler.
+ *
+ * Input Parameters:
+ *   buffer - Return address from the corresponding stack frame
+ *   size   - Maximum number of addresses that can be stored in buffer
+ *
+ * Returned Value:
+ *   up_interrupted_backtrace() returns the number of addresses returned in
+ *   buffer
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_INTERRUPTED_BACKTRACE
+int up_interrupted_backtrace(FAR void **buffer, int size)
+{
+  if (size <= 0 || buffer == NULL || !up_interrupt_context())
+    {
+      return 0;
+    }
+
+  return host_interrupted_backtrace(buffer, size);
+}
+#endif
@@ -0,0 +1,150 @@
+/****************************************************************************
+ * arch/sim/src/sim/up_hostbacktrace.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <execinfo.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "up_internal.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The host unwinder also reports the frames of the signal handler that
+ * runs the simulated interrupt.  This many frames are captured so that
+ * enough remain once those are dropped.
+ */
+
+#define HOST_BACKTRACE_MAX 64
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Set by the host signal handler in up_hostirq.c */
+
+#ifdef CONFIG_SMP
+void *g_interrupted_pc[CONFIG_SMP_NCPUS];
+#else
+void *g_interrupted_pc[1];
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: host_backtrace
+ *
+ * Description:
+ *   Return a backtrace of the host stack of the caller.  The calling
+ *   function itself is the first entry.
+ *
+ ****************************************************************************/
+
+int host_backtrace(void **buffer, int size)
+{
+  void *frames[HOST_BACKTRACE_MAX];
+  int n;
+
+  n = backtrace(frames, HOST_BACKTRACE_MAX);
+
+  /* Drop this function */
+
+  if (--n > size)
+    {
+      n = size;
+    }
+
+  if (n <= 0)
+    {
+      return 0;
+    }
+
+  memcpy(buffer, &frames[1], n * sizeof(void *));
+  return n;
+}
+
+/****************************************************************************
+ * Name: host_interrupted_backtrace
+ *
+ * Description:
+ *   Return a backtrace of the context interrupted by the host signal that
+ *   is being handled.  The frames of the signal handler are dropped:  The
+ *   host unwinder steps through the signal frame, so the backtrace
+ *   continues at the interrupted PC.
+ *
+ *   Zero is returned if the interrupted PC is unknown or is not found in
+ *   the backtrace.
+ *
+ ****************************************************************************/
+
+int host_interrupted_backtrace(void **buffer, int size)
+{
+  void *frames[HOST_BACKTRACE_MAX];
+  void *pc = INTERRUPTED_PC;
+  int n;
+  int i;
+
+  if (pc == NULL)
+    {
+      return 0;
+    }
+
+  n = backtrace(frames, HOST_BACKTRACE_MAX);
+  for (i = 0; i < n; i++)
+    {
+      if (frames[i] == pc)
+        {
+          n -= i;
+          if (n > size)
+            {
+              n = size;
+            }
+
+          memcpy(buffer, &frames[i], n * sizeof(void *));
+          return n;
+        }
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: host_backtrace_initialize
+ *
+ * Description:
+ *   The first call to the host backtrace() may load the host unwinder
+ *   library, which allocates memory and is not safe in a signal handler.
+ *   Make that first call at initialization time.
+ *
+ ****************************************************************************/
+
+void host_backtrace_initialize(void)
+{
+  void *frame;
+
+  backtrace(&frame, 1);
+}
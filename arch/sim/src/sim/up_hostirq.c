@@ -22,6 +22,10 @@
  * Included Files
  ****************************************************************************/
 
+#ifdef __linux__
+#  define _GNU_SOURCE 1
+#endif
+
 #include <signal.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -53,12 +57,44 @@ union sigset_u
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: up_interrupted_pc
+ *
+ * Description:
+ *   Return the host PC at which the context interrupted by a signal will
+ *   resume, or NULL if it is not known for this host.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_BACKTRACE
+static void *up_interrupted_pc(void *context)
+{
+  ucontext_t *uc = context;
+
+#if defined(__linux__) && defined(__x86_64__)
+  return (void *)uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__linux__) && defined(__i386__)
+  return (void *)uc->uc_mcontext.gregs[REG_EIP];
+#elif defined(__linux__) && defined(__arm__)
+  return (void *)uc->uc_mcontext.arm_pc;
+#elif defined(__APPLE__) && defined(__x86_64__)
+  return (void *)uc->uc_mcontext->__ss.__rip;
+#else
+  return NULL;
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: up_handle_irq
  ****************************************************************************/
 
 static void up_handle_irq(int irq, siginfo_t *info, void *context)
 {
+#ifdef CONFIG_ARCH_HAVE_BACKTRACE
+  INTERRUPTED_PC = up_interrupted_pc(context);
+#endif
+
   up_doirq(irq, context);
 }
 
@@ -111,6 +147,12 @@ void up_irq_restore(uint64_t flags)
 
 void up_irqinitialize(void)
 {
+#ifdef CONFIG_ARCH_HAVE_BACKTRACE
+  /* Load the host unwinder before it may be used in a signal handler */
+
+  host_backtrace_initialize();
+#endif
+
 #ifdef CONFIG_SMP
   /* Register the pause handler */
 
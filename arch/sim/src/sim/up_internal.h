@@ -123,6 +123,21 @@ extern volatile void *g_current_regs[1];
 
 #endif
 
+#ifdef CONFIG_ARCH_HAVE_BACKTRACE
+/* g_interrupted_pc[] holds the host PC at which the context interrupted by
+ * the simulated interrupt being processed will resume.  Access must be
+ * through the macro INTERRUPTED_PC.
+ */
+
+#ifdef CONFIG_SMP
+extern void *g_interrupted_pc[CONFIG_SMP_NCPUS];
+#  define INTERRUPTED_PC (g_interrupted_pc[up_cpu_index()])
+#else
+extern void *g_interrupted_pc[1];
+#  define INTERRUPTED_PC (g_interrupted_pc[0])
+#endif
+#endif /* CONFIG_ARCH_HAVE_BACKTRACE */
+
 /* The command line  arguments passed to simulator */
 
 extern int g_argc;
@@ -158,6 +173,14 @@ void host_free(void *mem);
 void *host_realloc(void *oldmem, size_t size);
 void host_mallinfo(int *aordblks, int *uordblks);
 
+/* up_hostbacktrace.c *******************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_BACKTRACE
+int  host_backtrace(void **buffer, int size);
+int  host_interrupted_backtrace(void **buffer, int size);
+void host_backtrace_initialize(void);
+#endif
+
 /* up_hosttime.c ************************************************************/
 
 uint64_t host_gettime(bool rtc);
@@ -249,7 +249,15 @@ static int elf_loadbinary(FAR struct binary_s *binp,
 
   /* Return the load information */
 
+#ifdef CONFIG_ELF_XIP
+  /* The entry point is relative to the first read-only section which may
+   * have been left in place.
+   */
+
+  binp->entrypt   = (main_t)(loadinfo.textbase + loadinfo.ehdr.e_entry);
+#else
   binp->entrypt   = (main_t)(loadinfo.textalloc + loadinfo.ehdr.e_entry);
+#endif
   binp->stacksize = CONFIG_ELF_STACKSIZE;
 
   /* Add the ELF allocation to the alloc[] only if there is no address
@@ -117,6 +117,36 @@ int elf_findsection(FAR struct elf_loadinfo_s *loadinfo,
 
 int elf_findsymtab(FAR struct elf_loadinfo_s *loadinfo);
 
+/****************************************************************************
+ * Name: elf_loadsymtab
+ *
+ * Description:
+ *   Read the symbol table and its string table into memory.  Failure to
+ *   allocate memory for the tables is not an error:  The symbols are then
+ *   read from the file as they are needed.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_LOADSYMTAB
+int elf_loadsymtab(FAR struct elf_loadinfo_s *loadinfo);
+#endif
+
+/****************************************************************************
+ * Name: elf_freesymtab
+ *
+ * Description:
+ *   Release the memory copies of the symbol and string tables.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_LOADSYMTAB
+void elf_freesymtab(FAR struct elf_loadinfo_s *loadinfo);
+#endif
+
 /****************************************************************************
  * Name: elf_readsym
  *
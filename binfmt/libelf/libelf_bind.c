@@ -584,6 +584,19 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
       return ret;
     }
 
+#ifdef CONFIG_ELF_LOADSYMTAB
+  /* Read the symbol and string tables into memory so that the symbols
+   * referenced by the relocations do not have to be read one at a time.
+   */
+
+  ret = elf_loadsymtab(loadinfo);
+  if (ret < 0)
+    {
+      berr("elf_loadsymtab failed: %d\n", ret);
+      return ret;
+    }
+#endif
+
 #ifdef CONFIG_ARCH_ADDRENV
   /* If CONFIG_ARCH_ADDRENV=y, then the loaded ELF lies in a virtual address
    * space that may not be in place now.  elf_addrenv_select() will
@@ -636,6 +649,12 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
         }
     }
 
+#ifdef CONFIG_ELF_LOADSYMTAB
+  /* The symbol tables are no longer needed */
+
+  elf_freesymtab(loadinfo);
+#endif
+
 #if defined(CONFIG_ARCH_ADDRENV)
   /* Ensure that the I and D caches are coherent before starting the newly
    * loaded module by cleaning the D cache (i.e., flushing the D cache
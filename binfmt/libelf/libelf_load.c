@@ -25,8 +25,10 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/statfs.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
@@ -38,6 +40,8 @@
 #include <nuttx/addrenv.h>
 #include <nuttx/elf.h>
 #include <nuttx/mm/mm.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/binfmt/elf.h>
 
 #include "libelf.h"
@@ -66,6 +70,90 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: elf_xipmap
+ *
+ * Description:
+ *   Get the address of the ELF file if it lies in memory-mapped media.
+ *   loadinfo->xipbase is left zero if the file cannot be used in place.
+ *
+ *   Other file systems (tmpfs, for example) also support FIOC_MMAP, but
+ *   their file data may be freed or moved while the program runs.  Only
+ *   ROMFS is used in place:  It supports FIOC_MMAP only if the underlying
+ *   device reports BIOC_XIPBASE, and its content can never change.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_XIP
+static void elf_xipmap(FAR struct elf_loadinfo_s *loadinfo)
+{
+  FAR struct inode *inode = loadinfo->file.f_inode;
+  struct statfs buf;
+  FAR void *addr;
+  int ret;
+
+  if (inode == NULL || !INODE_IS_MOUNTPT(inode) ||
+      inode->u.i_mops == NULL || inode->u.i_mops->statfs == NULL)
+    {
+      return;
+    }
+
+  ret = inode->u.i_mops->statfs(inode, &buf);
+  if (ret < 0 || buf.f_type != ROMFS_MAGIC)
+    {
+      return;
+    }
+
+  ret = file_ioctl(&loadinfo->file, FIOC_MMAP,
+                   (unsigned long)((uintptr_t)&addr));
+  if (ret >= 0)
+    {
+      binfo("ELF file is mapped at %p\n", addr);
+      loadinfo->xipbase = (uintptr_t)addr;
+    }
+}
+
+/****************************************************************************
+ * Name: elf_xipsection
+ *
+ * Description:
+ *   Return true if the section can be used in place:  It must be a
+ *   read-only section with data in the file, it must be suitably aligned
+ *   in the media, and no relocations may apply to it.
+ *
+ ****************************************************************************/
+
+static bool elf_xipsection(FAR struct elf_loadinfo_s *loadinfo, int index)
+{
+  FAR Elf_Shdr *shdr = &loadinfo->shdr[index];
+  int i;
+
+  if (loadinfo->xipbase == 0 || shdr->sh_type == SHT_NOBITS ||
+      (shdr->sh_flags & (SHF_ALLOC | SHF_WRITE)) != SHF_ALLOC)
+    {
+      return false;
+    }
+
+  if (shdr->sh_addralign > 1 &&
+      ((loadinfo->xipbase + shdr->sh_offset) % shdr->sh_addralign) != 0)
+    {
+      return false;
+    }
+
+  for (i = 0; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      if ((loadinfo->shdr[i].sh_type == SHT_REL ||
+           loadinfo->shdr[i].sh_type == SHT_RELA) &&
+          loadinfo->shdr[i].sh_info == index)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: elf_elfsize
  *
@@ -107,6 +195,12 @@ static void elf_elfsize(struct elf_loadinfo_s *loadinfo)
             {
               datasize += ELF_ALIGNUP(shdr->sh_size);
             }
+#ifdef CONFIG_ELF_XIP
+          else if (elf_xipsection(loadinfo, i))
+            {
+              /* The section will be used in place */
+            }
+#endif
           else
             {
               textsize += ELF_ALIGNUP(shdr->sh_size);
@@ -160,6 +254,17 @@ static inline int elf_loadfile(FAR struct elf_loadinfo_s *loadinfo)
           continue;
         }
 
+#ifdef CONFIG_ELF_XIP
+      /* Leave the section in place if possible */
+
+      if (elf_xipsection(loadinfo, i))
+        {
+          shdr->sh_addr = loadinfo->xipbase + shdr->sh_offset;
+          binfo("%d. XIP at %08lx\n", i, (unsigned long)shdr->sh_addr);
+          goto update_textbase;
+        }
+#endif
+
       /* SHF_WRITE indicates that the section address space is write-
        * able
        */
@@ -208,6 +313,19 @@ static inline int elf_loadfile(FAR struct elf_loadinfo_s *loadinfo)
       /* Setup the memory pointer for the next time through the loop */
 
       *pptr += ELF_ALIGNUP(shdr->sh_size);
+
+#ifdef CONFIG_ELF_XIP
+update_textbase:
+
+      /* Remember where the first read-only section ended up.  The entry
+       * point is relative to it.
+       */
+
+      if (loadinfo->textbase == 0 && (shdr->sh_flags & SHF_WRITE) == 0)
+        {
+          loadinfo->textbase = shdr->sh_addr;
+        }
+#endif
     }
 
   return OK;
@@ -250,6 +368,12 @@ int elf_load(FAR struct elf_loadinfo_s *loadinfo)
       goto errout_with_buffers;
     }
 
+#ifdef CONFIG_ELF_XIP
+  /* Check if the file can be used in place */
+
+  elf_xipmap(loadinfo);
+#endif
+
   /* Determine total size to allocate */
 
   elf_elfsize(loadinfo);
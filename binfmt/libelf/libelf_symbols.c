@@ -30,6 +30,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/kmalloc.h>
 #include <nuttx/binfmt/elf.h>
 #include <nuttx/binfmt/symtab.h>
 
@@ -51,7 +52,8 @@
  * Name: elf_symname
  *
  * Description:
- *   Get the symbol name in loadinfo->iobuffer[].
+ *   Get the symbol name.  The name is returned in the string table in
+ *   memory if it has been loaded or, otherwise, in loadinfo->iobuffer[].
  *
  * Returned Value:
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -64,7 +66,7 @@
  ****************************************************************************/
 
 static int elf_symname(FAR struct elf_loadinfo_s *loadinfo,
-                       FAR const Elf_Sym *sym)
+                       FAR const Elf_Sym *sym, FAR const char **name)
 {
   FAR uint8_t *buffer;
   off_t  offset;
@@ -82,6 +84,26 @@ static int elf_symname(FAR struct elf_loadinfo_s *loadinfo,
       return -ESRCH;
     }
 
+#ifdef CONFIG_ELF_LOADSYMTAB
+  if (loadinfo->strtab != NULL)
+    {
+      FAR Elf_Shdr *strtab = &loadinfo->shdr[loadinfo->strtabidx];
+
+      /* The name must be NUL terminated within the string table */
+
+      if (sym->st_name >= strtab->sh_size ||
+          memchr(&loadinfo->strtab[sym->st_name], '\0',
+                 strtab->sh_size - sym->st_name) == NULL)
+        {
+          berr("Bad symbol name offset: %lu\n", (unsigned long)sym->st_name);
+          return -EINVAL;
+        }
+
+      *name = &loadinfo->strtab[sym->st_name];
+      return OK;
+    }
+#endif
+
   offset = loadinfo->shdr[loadinfo->strtabidx].sh_offset + sym->st_name;
 
   /* Loop until we get the entire symbol name into memory */
@@ -120,8 +142,11 @@ static int elf_symname(FAR struct elf_loadinfo_s *loadinfo,
 
       if (memchr(buffer, '\0', readlen) != NULL)
         {
-          /* Yes, the buffer contains a NUL terminator. */
+          /* Yes, the buffer contains a NUL terminator.  Only now return
+           * the name:  elf_reallocbuffer() may have moved the I/O buffer.
+           */
 
+          *name = (FAR const char *)loadinfo->iobuffer;
           return OK;
         }
 
@@ -183,6 +208,77 @@ int elf_findsymtab(FAR struct elf_loadinfo_s *loadinfo)
   return OK;
 }
 
+/****************************************************************************
+ * Name: elf_loadsymtab
+ *
+ * Description:
+ *   Read the symbol table and its string table into memory.  Failure to
+ *   allocate memory for the tables is not an error:  The symbols are then
+ *   read from the file as they are needed.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_LOADSYMTAB
+int elf_loadsymtab(FAR struct elf_loadinfo_s *loadinfo)
+{
+  FAR Elf_Shdr *symtab = &loadinfo->shdr[loadinfo->symtabidx];
+  FAR Elf_Shdr *strtab = &loadinfo->shdr[loadinfo->strtabidx];
+  int ret;
+
+  loadinfo->symtab = (FAR Elf_Sym *)kmm_malloc(symtab->sh_size);
+  loadinfo->strtab = (FAR char *)kmm_malloc(strtab->sh_size);
+  if (loadinfo->symtab == NULL || loadinfo->strtab == NULL)
+    {
+      binfo("No memory for the symbol tables, reading from the file\n");
+      elf_freesymtab(loadinfo);
+      return OK;
+    }
+
+  ret = elf_read(loadinfo, (FAR uint8_t *)loadinfo->symtab,
+                 symtab->sh_size, symtab->sh_offset);
+  if (ret >= 0)
+    {
+      ret = elf_read(loadinfo, (FAR uint8_t *)loadinfo->strtab,
+                     strtab->sh_size, strtab->sh_offset);
+    }
+
+  if (ret < 0)
+    {
+      berr("Failed to read the symbol tables: %d\n", ret);
+      elf_freesymtab(loadinfo);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: elf_freesymtab
+ *
+ * Description:
+ *   Release the memory copies of the symbol and string tables.
+ *
+ ****************************************************************************/
+
+void elf_freesymtab(FAR struct elf_loadinfo_s *loadinfo)
+{
+  if (loadinfo->symtab != NULL)
+    {
+      kmm_free(loadinfo->symtab);
+      loadinfo->symtab = NULL;
+    }
+
+  if (loadinfo->strtab != NULL)
+    {
+      kmm_free(loadinfo->strtab);
+      loadinfo->strtab = NULL;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: elf_readsym
  *
@@ -208,12 +304,20 @@ int elf_readsym(FAR struct elf_loadinfo_s *loadinfo, int index,
 
   /* Verify that the symbol table index lies within symbol table */
 
-  if (index < 0 || index > (symtab->sh_size / sizeof(Elf_Sym)))
+  if (index < 0 || index >= (symtab->sh_size / sizeof(Elf_Sym)))
     {
       berr("Bad relocation symbol index: %d\n", index);
       return -EINVAL;
     }
 
+#ifdef CONFIG_ELF_LOADSYMTAB
+  if (loadinfo->symtab != NULL)
+    {
+      memcpy(sym, &loadinfo->symtab[index], sizeof(Elf_Sym));
+      return OK;
+    }
+#endif
+
   /* Get the file offset to the symbol table entry */
 
   offset = symtab->sh_offset + sizeof(Elf_Sym) * index;
@@ -250,6 +354,7 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf_Sym *sym,
                  FAR const struct symtab_s *exports, int nexports)
 {
   FAR const struct symtab_s *symbol;
+  FAR const char *name;
   uintptr_t secbase;
   int ret;
 
@@ -275,7 +380,7 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf_Sym *sym,
       {
         /* Get the name of the undefined symbol */
 
-        ret = elf_symname(loadinfo, sym);
+        ret = elf_symname(loadinfo, sym, &name);
         if (ret < 0)
           {
             /* There are a few relocations for a few architectures that do
@@ -290,12 +395,10 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf_Sym *sym,
 
         /* Check if the base code exports a symbol of this name */
 
-        symbol = symtab_findbyname(exports, (FAR char *)loadinfo->iobuffer,
-                                   nexports);
+        symbol = symtab_findbyname(exports, name, nexports);
         if (!symbol)
           {
-            berr("SHN_UNDEF: Exported symbol \"%s\" not found\n",
-                 loadinfo->iobuffer);
+            berr("SHN_UNDEF: Exported symbol \"%s\" not found\n", name);
             return -ENOENT;
           }
 
@@ -305,7 +408,7 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf_Sym *sym,
 
         binfo("SHN_UNDEF: name=%s "
               "%08" PRIxPTR "+%08" PRIxPTR "=%08" PRIxPTR "\n",
-              loadinfo->iobuffer, (uintptr_t)sym->st_value,
+              name, (uintptr_t)sym->st_value,
               (uintptr_t)symbol->sym_value,
               (uintptr_t)(sym->st_value + symbol->sym_value));
 
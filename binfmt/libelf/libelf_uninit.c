@@ -107,5 +107,9 @@ int elf_freebuffers(struct elf_loadinfo_s *loadinfo)
       loadinfo->buflen    = 0;
     }
 
+#ifdef CONFIG_ELF_LOADSYMTAB
+  elf_freesymtab(loadinfo);
+#endif
+
   return OK;
 }
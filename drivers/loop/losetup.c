@@ -41,7 +41,9 @@
 #include <debug.h>
 #include <errno.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/loop.h>
 #include <nuttx/semaphore.h>
@@ -66,6 +68,14 @@ struct loop_struct_s
   uint8_t      opencnt;      /* Count of open references to the loop device */
   bool         writeenabled; /* true: can write to device */
   struct file  devfile;      /* File struct of char device/file */
+#ifdef CONFIG_SCHED_LPWORK
+  struct work_s work;        /* Performs queued requests */
+  FAR struct blk_request_s *head; /* Queue of submitted requests */
+  FAR struct blk_request_s *tail;
+  sem_t        idle;         /* Posted when the worker stops for teardown */
+  bool         busy;         /* true: worker is scheduled or running */
+  bool         teardown;     /* true: loteardown() waits on idle */
+#endif
 };
 
 /****************************************************************************
@@ -82,6 +92,10 @@ static ssize_t loop_write(FAR struct inode *inode,
                           blkcnt_t start_sector, unsigned int nsectors);
 static int     loop_geometry(FAR struct inode *inode,
                              FAR struct geometry *geometry);
+#ifdef CONFIG_SCHED_LPWORK
+static int     loop_submit(FAR struct inode *inode,
+                           FAR struct blk_request_s *req);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -94,9 +108,14 @@ static const struct block_operations g_bops =
   loop_read,     /* read */
   loop_write,    /* write */
   loop_geometry, /* geometry */
-  NULL           /* ioctl */
+  NULL,          /* ioctl */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
-  , NULL         /* unlink */
+  NULL,          /* unlink */
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  loop_submit    /* submit */
+#else
+  NULL           /* submit */
 #endif
 };
 
@@ -188,29 +207,35 @@ static int loop_close(FAR struct inode *inode)
 }
 
 /****************************************************************************
- * Name: loop_read
+ * Name: loop_readsectors
  *
- * Description:  Read the specified number of sectors
+ * Description:  Read sectors from the backing file
  *
  ****************************************************************************/
 
-static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
-                         blkcnt_t start_sector, unsigned int nsectors)
+static ssize_t loop_readsectors(FAR struct loop_struct_s *dev,
+                                FAR unsigned char *buffer,
+                                blkcnt_t start_sector,
+                                unsigned int nsectors)
 {
-  FAR struct loop_struct_s *dev;
   ssize_t nbytesread;
   off_t offset;
   off_t ret;
 
-  DEBUGASSERT(inode && inode->i_private);
-  dev = (FAR struct loop_struct_s *)inode->i_private;
-
   if (start_sector + nsectors > dev->nsectors)
     {
       ferr("ERROR: Read past end of file\n");
       return -EIO;
     }
 
+  /* The file position is shared with the request worker */
+
+  ret = loop_semtake(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
   /* Calculate the offset to read the sectors and seek to the position */
 
   offset = start_sector * dev->sectsize + dev->offset;
@@ -218,6 +243,7 @@ static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
   if (ret < 0)
     {
       ferr("ERROR: Seek failed for offset=%d: %d\n", (int)offset, (int)ret);
+      loop_semgive(dev);
       return -EIO;
     }
 
@@ -230,34 +256,42 @@ static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
       if (nbytesread < 0 && nbytesread != -EINTR)
         {
           ferr("ERROR: Read failed: %zd\n", nbytesread);
+          loop_semgive(dev);
           return (int)nbytesread;
         }
     }
   while (nbytesread < 0);
 
+  loop_semgive(dev);
+
   /* Return the number of sectors read */
 
   return nbytesread / dev->sectsize;
 }
 
 /****************************************************************************
- * Name: loop_write
+ * Name: loop_writesectors
  *
- * Description: Write the specified number of sectors
+ * Description: Write sectors to the backing file
  *
  ****************************************************************************/
 
-static ssize_t loop_write(FAR struct inode *inode,
-                          FAR const unsigned char *buffer,
-                          blkcnt_t start_sector, unsigned int nsectors)
+static ssize_t loop_writesectors(FAR struct loop_struct_s *dev,
+                                 FAR const unsigned char *buffer,
+                                 blkcnt_t start_sector,
+                                 unsigned int nsectors)
 {
-  FAR struct loop_struct_s *dev;
   ssize_t nbyteswritten;
   off_t offset;
   off_t ret;
 
-  DEBUGASSERT(inode && inode->i_private);
-  dev = (FAR struct loop_struct_s *)inode->i_private;
+  /* The file position is shared with the request worker */
+
+  ret = loop_semtake(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
 
   /* Calculate the offset to write the sectors and seek to the position */
 
@@ -277,16 +311,50 @@ static ssize_t loop_write(FAR struct inode *inode,
       if (nbyteswritten < 0 && nbyteswritten != -EINTR)
         {
           ferr("ERROR: file_write failed: %zd\n", nbyteswritten);
+          loop_semgive(dev);
           return nbyteswritten;
         }
     }
   while (nbyteswritten < 0);
 
+  loop_semgive(dev);
+
   /* Return the number of sectors written */
 
   return nbyteswritten / dev->sectsize;
 }
 
+/****************************************************************************
+ * Name: loop_read
+ *
+ * Description:  Read the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t loop_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                         blkcnt_t start_sector, unsigned int nsectors)
+{
+  DEBUGASSERT(inode && inode->i_private);
+  return loop_readsectors((FAR struct loop_struct_s *)inode->i_private,
+                          buffer, start_sector, nsectors);
+}
+
+/****************************************************************************
+ * Name: loop_write
+ *
+ * Description: Write the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t loop_write(FAR struct inode *inode,
+                          FAR const unsigned char *buffer,
+                          blkcnt_t start_sector, unsigned int nsectors)
+{
+  DEBUGASSERT(inode && inode->i_private);
+  return loop_writesectors((FAR struct loop_struct_s *)inode->i_private,
+                           buffer, start_sector, nsectors);
+}
+
 /****************************************************************************
  * Name: loop_geometry
  *
@@ -314,6 +382,159 @@ static int loop_geometry(FAR struct inode *inode,
   return -EINVAL;
 }
 
+/****************************************************************************
+ * Name: loop_worker
+ *
+ * Description:
+ *   Perform all queued requests on the low priority work queue.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LPWORK
+static void loop_worker(FAR void *arg)
+{
+  FAR struct loop_struct_s *dev = (FAR struct loop_struct_s *)arg;
+  FAR const struct blk_segment_s *seg;
+  FAR struct blk_request_s *req;
+  irqstate_t flags;
+  blkcnt_t sector;
+  ssize_t nsectors;
+  ssize_t ret;
+  int i;
+
+  for (; ; )
+    {
+      /* Remove the oldest request from the queue */
+
+      flags = enter_critical_section();
+      req = dev->head;
+      if (req != NULL)
+        {
+          dev->head = req->br_flink;
+          if (dev->head == NULL)
+            {
+              dev->tail = NULL;
+            }
+        }
+      else
+        {
+          /* The queue is drained.  Once busy is cleared the worker must
+           * not touch dev again:  loteardown() may free it.
+           */
+
+          dev->busy = false;
+          if (dev->teardown)
+            {
+              nxsem_post(&dev->idle);
+            }
+        }
+
+      leave_critical_section(flags);
+
+      if (req == NULL)
+        {
+          break;
+        }
+
+      /* Perform each segment, stopping at the first error or short
+       * transfer.
+       */
+
+      sector   = req->br_sector;
+      nsectors = 0;
+
+      for (i = 0; i < req->br_nsegs; i++)
+        {
+          seg = &req->br_segs[i];
+          if (req->br_op == BLKREQ_WRITE)
+            {
+              ret = loop_writesectors(dev, seg->bs_buffer, sector,
+                                      seg->bs_nsectors);
+            }
+          else
+            {
+              ret = loop_readsectors(dev, seg->bs_buffer, sector,
+                                     seg->bs_nsectors);
+            }
+
+          if (ret < 0)
+            {
+              if (nsectors == 0)
+                {
+                  nsectors = ret;
+                }
+
+              break;
+            }
+
+          nsectors += ret;
+          sector   += ret;
+
+          if (ret < seg->bs_nsectors)
+            {
+              break;
+            }
+        }
+
+      req->br_result = nsectors;
+      req->br_complete(req);
+    }
+}
+
+/****************************************************************************
+ * Name: loop_submit
+ *
+ * Description:
+ *   Queue a request.  Requests are performed in order on the low priority
+ *   work queue so that the caller may overlap the file I/O with other
+ *   work.
+ *
+ ****************************************************************************/
+
+static int loop_submit(FAR struct inode *inode,
+                       FAR struct blk_request_s *req)
+{
+  FAR struct loop_struct_s *dev;
+  irqstate_t flags;
+  int ret = OK;
+
+  DEBUGASSERT(inode && inode->i_private && req);
+  dev = (FAR struct loop_struct_s *)inode->i_private;
+
+  if (req->br_op == BLKREQ_WRITE && !dev->writeenabled)
+    {
+      return -EACCES;
+    }
+
+  req->br_flink = NULL;
+
+  flags = enter_critical_section();
+  if (dev->tail == NULL)
+    {
+      dev->head = req;
+    }
+  else
+    {
+      dev->tail->br_flink = req;
+    }
+
+  dev->tail = req;
+
+  /* The worker drains the whole queue, so it only needs to be scheduled if
+   * it is not already pending or running.
+   */
+
+  if (!dev->busy)
+    {
+      ret = work_queue(LPWORK, &dev->work, loop_worker, dev, 0);
+      dev->busy = (ret >= 0);
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -372,6 +593,11 @@ int losetup(FAR const char *devname, FAR const char *filename,
   /* Initialize the loop device structure. */
 
   nxsem_init(&dev->sem, 0, 1);
+#ifdef CONFIG_SCHED_LPWORK
+  nxsem_init(&dev->idle, 0, 0);
+  nxsem_set_protocol(&dev->idle, SEM_PRIO_NONE);
+#endif
+
   dev->nsectors  = (sb.st_size - offset) / sectsize;
   dev->sectsize  = sectsize;
   dev->offset    = offset;
@@ -435,6 +661,10 @@ int loteardown(FAR const char *devname)
 {
   FAR struct loop_struct_s *dev;
   FAR struct inode *inode;
+#ifdef CONFIG_SCHED_LPWORK
+  FAR struct blk_request_s *req;
+  irqstate_t flags;
+#endif
   int ret;
 
   /* Sanity check */
@@ -475,6 +705,44 @@ int loteardown(FAR const char *devname)
 
   ret = unregister_blockdriver(devname);
 
+#ifdef CONFIG_SCHED_LPWORK
+  /* Take the pending requests away from the worker.  If the worker is
+   * already running, it stops after its current request; wait for that
+   * before the device structure is freed.
+   */
+
+  flags     = enter_critical_section();
+  req       = dev->head;
+  dev->head = NULL;
+  dev->tail = NULL;
+
+  if (dev->busy && work_cancel(LPWORK, &dev->work) == OK)
+    {
+      dev->busy = false;
+    }
+
+  dev->teardown = dev->busy;
+  leave_critical_section(flags);
+
+  if (dev->teardown)
+    {
+      nxsem_wait_uninterruptible(&dev->idle);
+    }
+
+  /* Then fail every request that was never performed */
+
+  while (req != NULL)
+    {
+      FAR struct blk_request_s *next = req->br_flink;
+
+      req->br_result = -ENODEV;
+      req->br_complete(req);
+      req = next;
+    }
+
+  nxsem_destroy(&dev->idle);
+#endif
+
   /* Release the device structure */
 
   if (dev->devfile.f_inode != NULL)
@@ -74,6 +74,9 @@ struct ftl_struct_s
   uint16_t              refs;     /* Number of references */
   bool                  unlinked; /* The driver has been unlinked */
   FAR uint8_t          *eblock;   /* One, in-memory erase block */
+#ifdef CONFIG_FTL_SKIP_ERASE
+  uint8_t               erasestate; /* Value of an erased byte */
+#endif
 };
 
 /****************************************************************************
@@ -86,6 +89,13 @@ static ssize_t ftl_reload(FAR void *priv, FAR uint8_t *buffer,
                  off_t startblock, size_t nblocks);
 static ssize_t ftl_read(FAR struct inode *inode, FAR unsigned char *buffer,
                  blkcnt_t start_sector, unsigned int nsectors);
+#ifdef CONFIG_FTL_SKIP_ERASE
+static bool    ftl_program(FAR struct ftl_struct_s *dev,
+                 FAR const uint8_t *current, off_t startblock,
+                 size_t nblocks, FAR const uint8_t *buffer);
+#endif
+static int     ftl_update(FAR struct ftl_struct_s *dev, off_t startblock,
+                 size_t nblocks, FAR const uint8_t *buffer);
 static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
                  off_t startblock, size_t nblocks);
 static ssize_t ftl_write(FAR struct inode *inode,
@@ -222,9 +232,9 @@ static ssize_t ftl_read(FAR struct inode *inode, unsigned char *buffer,
 }
 
 /****************************************************************************
- * Name: ftl_flush
+ * Name: ftl_alloc_eblock
  *
- * Description: Write the specified number of sectors
+ * Description: Allocate the erase block buffer if it is not allocated yet
  *
  ****************************************************************************/
 
@@ -240,18 +250,175 @@ static int ftl_alloc_eblock(FAR struct ftl_struct_s *dev)
   return dev->eblock != NULL ? OK : -ENOMEM;
 }
 
+#ifdef CONFIG_FTL_SKIP_ERASE
+/****************************************************************************
+ * Name: ftl_program
+ *
+ * Description:
+ *   Try to update the R/W blocks of a partial erase block without erasing
+ *   it.  Blocks whose content does not change are skipped; blocks that are
+ *   still in the erased state are programmed in place.
+ *
+ * Returned Value:
+ *   true if the blocks were updated; false if the erase block must be
+ *   erased and rewritten instead.
+ *
+ ****************************************************************************/
+
+static bool ftl_program(FAR struct ftl_struct_s *dev,
+                        FAR const uint8_t *current, off_t startblock,
+                        size_t nblocks, FAR const uint8_t *buffer)
+{
+  size_t blocksize = dev->geo.blocksize;
+  size_t i;
+  size_t j;
+
+  /* First verify that every block to be changed is erased */
+
+  for (i = 0; i < nblocks; i++)
+    {
+      if (memcmp(current + i * blocksize, buffer + i * blocksize,
+                 blocksize) == 0)
+        {
+          continue;
+        }
+
+      for (j = 0; j < blocksize; j++)
+        {
+          if (current[i * blocksize + j] != dev->erasestate)
+            {
+              return false;
+            }
+        }
+    }
+
+  /* Then program the changed blocks */
+
+  for (i = 0; i < nblocks; i++)
+    {
+      if (memcmp(current + i * blocksize, buffer + i * blocksize,
+                 blocksize) != 0)
+        {
+          finfo("Program block=%" PRIdOFF " without erase\n",
+                startblock + (off_t)i);
+
+          if (MTD_BWRITE(dev->mtd, startblock + i, 1,
+                         buffer + i * blocksize) != 1)
+            {
+              /* Fall back to the erase and rewrite of the whole erase
+               * block.
+               */
+
+              ferr("ERROR: Write block %" PRIdOFF " failed\n",
+                   startblock + (off_t)i);
+              return false;
+            }
+        }
+    }
+
+  return true;
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_update
+ *
+ * Description:
+ *   Update 'nblocks' R/W blocks starting at 'startblock' which all lie in
+ *   the same erase block:  Read the erase block, merge in the new data,
+ *   erase it and write it back.
+ *
+ ****************************************************************************/
+
+static int ftl_update(FAR struct ftl_struct_s *dev, off_t startblock,
+                      size_t nblocks, FAR const uint8_t *buffer)
+{
+  off_t  mask = dev->blkper - 1;
+  off_t  rwblock;
+  off_t  eraseblock;
+  off_t  offset;
+  size_t nxfrd;
+  int    nbytes;
+  int    ret;
+
+  ret = ftl_alloc_eblock(dev);
+  if (ret < 0)
+    {
+      ferr("ERROR: Failed to allocate an erase block buffer\n");
+      return ret;
+    }
+
+  /* Read the full erase block into the buffer */
+
+  rwblock = startblock & ~mask;
+  nxfrd   = MTD_BREAD(dev->mtd, rwblock, dev->blkper, dev->eblock);
+  if (nxfrd != dev->blkper)
+    {
+      ferr("ERROR: Read erase block %" PRIdOFF " failed: %zd\n",
+           rwblock, nxfrd);
+      return -EIO;
+    }
+
+  offset = (startblock & mask) * dev->geo.blocksize;
+  nbytes = nblocks * dev->geo.blocksize;
+
+#ifdef CONFIG_FTL_SKIP_ERASE
+  /* Avoid the erase cycle if the blocks can be updated in place */
+
+  if (ftl_program(dev, dev->eblock + offset, startblock, nblocks, buffer))
+    {
+      return OK;
+    }
+#endif
+
+  /* Then erase the erase block */
+
+  eraseblock = rwblock / dev->blkper;
+  ret        = MTD_ERASE(dev->mtd, eraseblock, 1);
+  if (ret < 0)
+    {
+      ferr("ERROR: Erase block=%" PRIdOFF "failed: %d\n",
+           eraseblock, ret);
+      return ret;
+    }
+
+  /* Copy the user data into the buffered erase block */
+
+  finfo("Copy %d bytes into erase block=%" PRIdOFF
+        " at offset=%" PRIdOFF "\n", nbytes, eraseblock, offset);
+
+  memcpy(dev->eblock + offset, buffer, nbytes);
+
+  /* And write the erase block back to flash */
+
+  nxfrd = MTD_BWRITE(dev->mtd, rwblock, dev->blkper, dev->eblock);
+  if (nxfrd != dev->blkper)
+    {
+      ferr("ERROR: Write erase block %" PRIdOFF " failed: %zu\n",
+           rwblock, nxfrd);
+      return -EIO;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_flush
+ *
+ * Description: Write the specified number of sectors
+ *
+ ****************************************************************************/
+
 static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
                          off_t startblock, size_t nblocks)
 {
   struct ftl_struct_s *dev = (struct ftl_struct_s *)priv;
   off_t  alignedblock;
   off_t  mask;
-  off_t  rwblock;
   off_t  eraseblock;
-  off_t  offset;
   size_t remaining;
   size_t nxfrd;
-  int    nbytes;
+  size_t count;
   int    ret;
 
   /* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
@@ -269,77 +436,22 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
     {
       /* Check if the write is shorter than to the end of the erase block */
 
-      bool short_write = (remaining < (alignedblock - startblock));
-
-      ret = ftl_alloc_eblock(dev);
-      if (ret < 0)
+      count = alignedblock - startblock;
+      if (remaining < count)
         {
-          ferr("ERROR: Failed to allocate an erase block buffer\n");
-          return ret;
+          count = remaining;
         }
 
-      /* Read the full erase block into the buffer */
-
-      rwblock = startblock & ~mask;
-      nxfrd   = MTD_BREAD(dev->mtd, rwblock, dev->blkper, dev->eblock);
-      if (nxfrd != dev->blkper)
-        {
-          ferr("ERROR: Read erase block %" PRIdOFF " failed: %zd\n",
-               rwblock, nxfrd);
-          return -EIO;
-        }
-
-      /* Then erase the erase block */
-
-      eraseblock = rwblock / dev->blkper;
-      ret        = MTD_ERASE(dev->mtd, eraseblock, 1);
+      ret = ftl_update(dev, startblock, count, buffer);
       if (ret < 0)
         {
-          ferr("ERROR: Erase block=%" PRIdOFF "failed: %d\n",
-               eraseblock, ret);
           return ret;
         }
 
-      /* Copy the user data at the end of the buffered erase block */
-
-      offset = (startblock & mask) * dev->geo.blocksize;
-
-      if (short_write)
-        {
-          nbytes = remaining * dev->geo.blocksize;
-        }
-      else
-        {
-          nbytes = dev->geo.erasesize - offset;
-        }
-
-      finfo("Copy %d bytes into erase block=%" PRIdOFF
-            " at offset=%" PRIdOFF "\n", nbytes, eraseblock, offset);
-
-      memcpy(dev->eblock + offset, buffer, nbytes);
-
-      /* And write the erase block back to flash */
-
-      nxfrd = MTD_BWRITE(dev->mtd, rwblock, dev->blkper, dev->eblock);
-      if (nxfrd != dev->blkper)
-        {
-          ferr("ERROR: Write erase block %" PRIdOFF " failed: %zu\n",
-               rwblock, nxfrd);
-          return -EIO;
-        }
-
       /* Then update for amount written */
 
-      if (short_write)
-        {
-          remaining = 0;
-        }
-      else
-        {
-          remaining -= dev->blkper - (startblock & mask);
-        }
-
-      buffer += nbytes;
+      remaining -= count;
+      buffer    += count * dev->geo.blocksize;
     }
 
   /* How handle full erase pages in the middle */
@@ -381,50 +493,11 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
 
   if (remaining > 0)
     {
-      ret = ftl_alloc_eblock(dev);
-      if (ret < 0)
-        {
-          ferr("ERROR: Failed to allocate an erase block buffer\n");
-          return ret;
-        }
-
-      /* Read the full erase block into the buffer */
-
-      nxfrd = MTD_BREAD(dev->mtd, alignedblock, dev->blkper, dev->eblock);
-      if (nxfrd != dev->blkper)
-        {
-          ferr("ERROR: Read erase block %" PRIdOFF " failed: %zu\n",
-               alignedblock, nxfrd);
-          return -EIO;
-        }
-
-      /* Then erase the erase block */
-
-      eraseblock = alignedblock / dev->blkper;
-      ret        = MTD_ERASE(dev->mtd, eraseblock, 1);
+      ret = ftl_update(dev, alignedblock, remaining, buffer);
       if (ret < 0)
         {
-          ferr("ERROR: Erase block=%" PRIdOFF "failed: %d\n",
-               eraseblock, ret);
           return ret;
         }
-
-      /* Copy the user data at the beginning the buffered erase block */
-
-      nbytes = remaining * dev->geo.blocksize;
-      finfo("Copy %d bytes into erase block=%" PRIdOFF " at offset=0\n",
-             nbytes, alignedblock);
-      memcpy(dev->eblock, buffer, nbytes);
-
-      /* And write the erase back to flash */
-
-      nxfrd = MTD_BWRITE(dev->mtd, alignedblock, dev->blkper, dev->eblock);
-      if (nxfrd != dev->blkper)
-        {
-          ferr("ERROR: Write erase block %" PRIdOFF " failed: %zu\n",
-               alignedblock, nxfrd);
-          return -EIO;
-        }
     }
 
   return nblocks;
@@ -613,6 +686,14 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
           return ret;
         }
 
+#ifdef CONFIG_FTL_SKIP_ERASE
+      /* Get the erased state of the FLASH.  Most FLASH erases to 0xff */
+
+      dev->erasestate = 0xff;
+      MTD_IOCTL(mtd, MTDIOC_ERASESTATE,
+                (unsigned long)((uintptr_t)&dev->erasestate));
+#endif
+
       /* Get the number of R/W blocks per erase block */
 
       dev->blkper = dev->geo.erasesize / dev->geo.blocksize;
@@ -197,7 +197,7 @@ struct smart_cache_s
 {
   uint16_t              logical;          /* Logical sector number */
   uint16_t              physical;         /* Associated physical sector */
-  uint16_t              birth;            /* The "birthday" of this entry */
+  uint16_t              used;             /* Referenced since the clock hand passed */
 };
 #endif
 
@@ -267,7 +267,9 @@ struct smart_struct_s
   uint16_t              cache_entries;    /* Number of valid entries in the cache */
   uint16_t              cache_lastlog;    /* Keep track of the last sector accessed */
   uint16_t              cache_lastphys;   /* Keep the physical sector number also */
-  uint16_t              cache_nextbirth;  /* Sector cache aging value */
+  uint16_t              cache_hand;       /* Next entry to consider for replacement */
+  uint32_t              cache_hits;       /* Lookups found in the cache */
+  uint32_t              cache_misses;     /* Lookups that scanned the device */
 #endif
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
   FAR uint8_t          *erasecounts;      /* Number of erases for each erase block */
@@ -1147,7 +1149,9 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
   dev->cache_entries = 0;
   dev->cache_lastlog = 0xffff;
-  dev->cache_nextbirth = 0;
+  dev->cache_hand = 0;
+  dev->cache_hits = 0;
+  dev->cache_misses = 0;
 #endif
 
   if (dev->rwbuffer != NULL)
@@ -1442,9 +1446,13 @@ errout:
  *              map cache.  The cache is used to minimize RAM by eliminating
  *              a one-to-one mapping of all logical sectors and only keeping
  *              a fixed number of mappings per the
- *              CONFIG_MTD_SMART_SECTOR_CACHE_SIZE parameter.  Sectors are
- *              automatically managed and removed based on the time since
- *              they were accessed last.
+ *              CONFIG_MTD_SMART_SECTOR_CACHE_SIZE parameter.  When the
+ *              cache is full, the entry to replace is chosen with the CLOCK
+ *              (second chance) algorithm:  The clock hand sweeps the cache,
+ *              clearing the used flag of each entry it passes, and stops at
+ *              the first entry that has not been referenced since the hand
+ *              last passed it.  This approximates least recently used
+ *              replacement without keeping or aging timestamps.
  *
  ****************************************************************************/
 
@@ -1453,38 +1461,55 @@ static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev,
             uint16_t logical, uint16_t physical, int line)
 {
   uint16_t index;
-  uint16_t x;
-  uint16_t oldest;
+  int sweep;
 
   /* If we aren't full yet, just add the sector to the end of the list */
 
-  index = 1;
   if (dev->cache_entries < CONFIG_MTD_SMART_SECTOR_CACHE_SIZE)
     {
-      oldest = 0;
-      index  = dev->cache_entries++;
+      index = dev->cache_entries++;
     }
   else
     {
-      /* Cache is full.  We must find the least accessed entry and replace
-       * it
+      /* Cache is full.  Advance the clock hand to the first entry that
+       * has not been used since the hand last passed it.  After two
+       * sweeps every entry that is not a system sector has lost its used
+       * flag, so the search is bounded by that.
        */
 
-      oldest = 0xffff;
-      for (x = 0; x < CONFIG_MTD_SMART_SECTOR_CACHE_SIZE; x++)
+      for (sweep = 0; ; sweep++)
         {
+          if (sweep >= 2 * CONFIG_MTD_SMART_SECTOR_CACHE_SIZE)
+            {
+              /* Every entry holds a system sector.  Leave the mapping
+               * uncached; it will be found by scanning the volume.
+               */
+
+              return -ENOSPC;
+            }
+
+          index = dev->cache_hand;
+          if (++dev->cache_hand >= CONFIG_MTD_SMART_SECTOR_CACHE_SIZE)
+            {
+              dev->cache_hand = 0;
+            }
+
           /* Never replace cache entries for system sectors */
 
-          if (dev->scache[x].logical < SMART_FIRST_ALLOC_SECTOR)
-            continue;
+          if (dev->scache[index].logical < SMART_FIRST_ALLOC_SECTOR)
+            {
+              continue;
+            }
 
-          /* If the hit count is zero, then choose this entry */
+          /* Give recently used entries a second chance */
 
-          if (dev->scache[x].birth < oldest)
+          if (dev->scache[index].used)
             {
-              oldest = dev->scache[x].birth;
-              index  = x;
+              dev->scache[index].used = 0;
+              continue;
             }
+
+          break;
         }
     }
 
@@ -1492,7 +1517,7 @@ static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev,
 
   dev->scache[index].logical = logical;
   dev->scache[index].physical = physical;
-  dev->scache[index].birth = dev->cache_nextbirth++;
+  dev->scache[index].used = 1;
   dev->cache_lastlog = logical;
   dev->cache_lastphys = physical;
 
@@ -1502,18 +1527,6 @@ static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev,
           logical, physical, index, line);
     }
 
-  /* Test if the birthdays need to be adjusted */
-
-  if (oldest >= CONFIG_MTD_SMART_SECTOR_CACHE_SIZE + 1024)
-    {
-      for (x = 0; x < dev->cache_entries; x++)
-        {
-          dev->scache[x].birth -= 1024;
-        }
-
-      dev->cache_nextbirth -= 1024;
-    }
-
   return index;
 }
 #endif
@@ -1522,7 +1535,7 @@ static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev,
  * Name: smart_cache_lookup
  *
  * Description: Perform a cache lookup for the requested logical sector.
- *              If the sector is in the cache, then update the hitcount and
+ *              If the sector is in the cache, then mark the entry used and
  *              return the physical mapping.  If a cache miss occurs, then
  *              the routine will scan the volume to find the logical sector
  *              and add / replace a cache entry with the newly located
@@ -1549,6 +1562,7 @@ static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev,
 
   if (logical == dev->cache_lastlog)
     {
+      dev->cache_hits++;
       return dev->cache_lastphys;
     }
 
@@ -1561,6 +1575,8 @@ static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev,
           /* Entry found in the cache.  Grab the physical mapping. */
 
           physical = dev->scache[x].physical;
+          dev->scache[x].used = 1;
+          dev->cache_hits++;
           break;
         }
     }
@@ -1571,6 +1587,8 @@ static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev,
 
   if (physical == 0xffff)
     {
+      dev->cache_misses++;
+
       /* Now scan the MTD device.  Instead of scanning start to end, we
        * span the erase blocks and read one sector from each at a time.
        * this helps speed up the search on volumes that aren't full
@@ -1695,6 +1713,8 @@ static void smart_update_cache(FAR struct smart_struct_s *dev, uint16_t
                   dev->scache[dev->cache_entries - 1].logical;
                 dev->scache[x].physical =
                   dev->scache[dev->cache_entries - 1].physical;
+                dev->scache[x].used =
+                  dev->scache[dev->cache_entries - 1].used;
                 dev->cache_entries--;
             }
 
@@ -1904,6 +1924,33 @@ static int smart_set_wear_level(FAR struct smart_struct_s *dev,
 }
 #endif
 
+/****************************************************************************
+ * Name: smart_header_erased
+ *
+ * Description: Returns true if a sector header is still in the erased
+ *              state, i.e. the physical sector has not been written since
+ *              its erase block was last erased.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FAST_SCAN
+static bool smart_header_erased(FAR const struct smart_sect_header_s *header)
+{
+  FAR const uint8_t *ptr = (FAR const uint8_t *)header;
+  int i;
+
+  for (i = 0; i < sizeof(struct smart_sect_header_s); i++)
+    {
+      if (ptr[i] != CONFIG_SMARTFS_ERASEDSTATE)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: smart_scan
  *
@@ -2076,6 +2123,21 @@ static int smart_scan(FAR struct smart_struct_s *dev)
           goto err_out;
         }
 
+#ifdef CONFIG_MTD_SMART_FAST_SCAN
+      /* Free sectors are always allocated in order from the start of their
+       * erase block.  So if this sector was never written, then none of
+       * the following sectors in the same erase block were written either
+       * and they are all free.  Skip to the next erase block.
+       */
+
+      if (smart_header_erased(&header))
+        {
+          sector = (sector / dev->sectorsperblk + 1) *
+                   dev->sectorsperblk - 1;
+          continue;
+        }
+#endif
+
       /* Get the logical sector number for this physical sector */
 
       logicalsector = *((FAR uint16_t *) header.logicalsector);
@@ -5566,6 +5628,10 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #endif
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
       procfs_data->uneven_wearcount = dev->uneven_wearcount;
+#endif
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+      procfs_data->cachehits      = dev->cache_hits;
+      procfs_data->cachemisses    = dev->cache_misses;
 #endif
       ret = OK;
       goto ok_out;
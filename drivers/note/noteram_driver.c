@@ -515,22 +515,20 @@ static ssize_t noteram_get(FAR uint8_t *buffer, size_t buflen)
       goto errout_with_csection;
     }
 
-  /* Loop until the note has been transferred to the user buffer */
+  /* Copy the note to the user buffer in at most two pieces:  Up to the
+   * end of the circular buffer and then the wrapped remainder.
+   */
 
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
+  remaining = CONFIG_DRIVER_NOTERAM_BUFSIZE - read;
+  if (remaining > (unsigned int)notelen)
     {
-      /* Copy the next byte at the read index */
-
-      *buffer++ = g_noteram_info.ni_buffer[read];
-
-      /* Adjust indices and counts */
-
-      read = noteram_next(read, 1);
-      remaining--;
+      remaining = (unsigned int)notelen;
     }
 
-  g_noteram_info.ni_read = read;
+  memcpy(buffer, &g_noteram_info.ni_buffer[read], remaining);
+  memcpy(buffer + remaining, g_noteram_info.ni_buffer, notelen - remaining);
+
+  g_noteram_info.ni_read = noteram_next(read, notelen);
 
 errout_with_csection:
   leave_critical_section(flags);
@@ -784,9 +782,9 @@ static int noteram_ioctl(struct file *filep, int cmd, unsigned long arg)
 
 void sched_note_add(FAR const void *note, size_t notelen)
 {
-  FAR const char *buf = note;
+  FAR const uint8_t *buf = note;
   unsigned int head;
-  unsigned int next;
+  unsigned int space;
   irqstate_t flags;
 
   flags = up_irq_save();
@@ -824,44 +822,45 @@ void sched_note_add(FAR const void *note, size_t notelen)
   DEBUGASSERT(note != NULL && notelen < CONFIG_DRIVER_NOTERAM_BUFSIZE);
   head = g_noteram_info.ni_head;
 
-  /* Loop until all bytes have been transferred to the circular buffer */
+  /* Make room for the whole note first.  One byte of the circular buffer
+   * always stays unused so that a full buffer can be told from an empty
+   * one.
+   */
 
-  while (notelen > 0)
+  while (noteram_length() + notelen >= CONFIG_DRIVER_NOTERAM_BUFSIZE)
     {
-      /* Get the next head index.  Would it collide with the current tail
-       * index?
-       */
-
-      next = noteram_next(head, 1);
-      if (next == g_noteram_info.ni_tail)
+      if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
         {
-          if (g_noteram_info.ni_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
-            {
-              /* Stop recording if not in overwrite mode */
+          /* Stop recording if not in overwrite mode */
 
-              g_noteram_info.ni_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
+          g_noteram_info.ni_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
 
 #ifdef CONFIG_SMP
-              spin_unlock_wo_note(&g_noteram_lock);
+          spin_unlock_wo_note(&g_noteram_lock);
 #endif
-              up_irq_restore(flags);
-              return;
-            }
-
-          /* Yes, then remove the note at the tail index */
-
-          noteram_remove();
+          up_irq_restore(flags);
+          return;
         }
 
-      /* Save the next byte at the head index */
+      /* Remove the note at the tail index */
+
+      noteram_remove();
+    }
 
-      g_noteram_info.ni_buffer[head] = *buf++;
+  /* Then copy the note in at most two pieces:  Up to the end of the
+   * circular buffer and then the wrapped remainder.
+   */
 
-      head = next;
-      notelen--;
+  space = CONFIG_DRIVER_NOTERAM_BUFSIZE - head;
+  if (space > notelen)
+    {
+      space = notelen;
     }
 
-  g_noteram_info.ni_head = head;
+  memcpy(&g_noteram_info.ni_buffer[head], buf, space);
+  memcpy(g_noteram_info.ni_buffer, buf + space, notelen - space);
+
+  g_noteram_info.ni_head = noteram_next(head, notelen);
 
 #ifdef CONFIG_SMP
   spin_unlock_wo_note(&g_noteram_lock);
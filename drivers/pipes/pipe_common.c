@@ -63,6 +63,13 @@
 #  define pipe_dumpbuffer(m,a,n)
 #endif
 
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
+                                  pollevent_t eventset);
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -76,6 +83,110 @@ static int pipecommon_semtake(FAR sem_t *sem)
   return nxsem_wait_uninterruptible(sem);
 }
 
+/****************************************************************************
+ * Name: pipecommon_bufferused
+ *
+ * Description:
+ *   Return the number of bytes held in the pipe buffer.
+ *
+ ****************************************************************************/
+
+static size_t pipecommon_bufferused(FAR struct pipe_dev_s *dev)
+{
+  if (dev->d_wrndx < dev->d_rdndx)
+    {
+      return (dev->d_bufsize - dev->d_rdndx) + dev->d_wrndx;
+    }
+  else
+    {
+      return dev->d_wrndx - dev->d_rdndx;
+    }
+}
+
+/****************************************************************************
+ * Name: pipecommon_bufferfull
+ ****************************************************************************/
+
+static inline bool pipecommon_bufferfull(FAR struct pipe_dev_s *dev)
+{
+  return pipecommon_bufferused(dev) >= dev->d_bufsize - 1;
+}
+
+/****************************************************************************
+ * Name: pipecommon_resize
+ *
+ * Description:
+ *   Change the size of the pipe buffer.  Any buffered data is preserved.
+ *   If the buffer has not been allocated yet, only the size that will be
+ *   allocated on the first open is changed.
+ *
+ * Returned Value:
+ *   The new buffer size on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int pipecommon_resize(FAR struct pipe_dev_s *dev, size_t bufsize)
+{
+  FAR uint8_t *buffer;
+  size_t nused;
+  size_t nbytes;
+  int sval;
+
+  if (bufsize < 2 || bufsize > CONFIG_DEV_PIPE_MAXSIZE)
+    {
+      return -EINVAL;
+    }
+
+  /* The buffer must have room for the data that it already holds */
+
+  nused = pipecommon_bufferused(dev);
+  if (bufsize - 1 < nused)
+    {
+      return -EBUSY;
+    }
+
+  if (dev->d_buffer != NULL && bufsize != dev->d_bufsize)
+    {
+      buffer = (FAR uint8_t *)kmm_malloc(bufsize);
+      if (buffer == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      /* Copy the buffered data to the beginning of the new buffer */
+
+      nbytes = dev->d_bufsize - dev->d_rdndx;
+      if (nbytes > nused)
+        {
+          nbytes = nused;
+        }
+
+      memcpy(buffer, &dev->d_buffer[dev->d_rdndx], nbytes);
+      memcpy(&buffer[nbytes], dev->d_buffer, nused - nbytes);
+
+      kmm_free(dev->d_buffer);
+      dev->d_buffer = buffer;
+      dev->d_rdndx  = 0;
+      dev->d_wrndx  = nused;
+    }
+
+  dev->d_bufsize = bufsize;
+
+  /* Writers waiting for space may be able to proceed now */
+
+  if (dev->d_buffer != NULL && !pipecommon_bufferfull(dev))
+    {
+      pipecommon_pollnotify(dev, POLLOUT);
+
+      while (nxsem_get_value(&dev->d_wrsem, &sval) == 0 && sval < 0)
+        {
+          nxsem_post(&dev->d_wrsem);
+        }
+    }
+
+  return bufsize;
+}
+
 /****************************************************************************
  * Name: pipecommon_pollnotify
  ****************************************************************************/
@@ -400,6 +511,8 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
   FAR uint8_t           *start  = (FAR uint8_t *)buffer;
 #endif
   ssize_t                nread  = 0;
+  size_t                 nbytes;
+  bool                   wasfull;
   int                    sval;
   int                    ret;
 
@@ -460,24 +573,48 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
     }
 
   /* Then return whatever is available in the pipe (which is at least one
-   * byte).
+   * byte).  The data is copied in at most two pieces:  Up to the end of
+   * the buffer and then the wrapped remainder.
    */
 
+  wasfull = pipecommon_bufferfull(dev);
+
   nread = 0;
   while ((size_t)nread < len && dev->d_wrndx != dev->d_rdndx)
     {
-      *buffer++ = dev->d_buffer[dev->d_rdndx];
-      if (++dev->d_rdndx >= dev->d_bufsize)
+      if (dev->d_wrndx > dev->d_rdndx)
         {
-          dev->d_rdndx = 0;
+          nbytes = dev->d_wrndx - dev->d_rdndx;
+        }
+      else
+        {
+          nbytes = dev->d_bufsize - dev->d_rdndx;
         }
 
-      nread++;
+      if (nbytes > len - nread)
+        {
+          nbytes = len - nread;
+        }
+
+      memcpy(buffer, &dev->d_buffer[dev->d_rdndx], nbytes);
+      buffer += nbytes;
+      nread  += nbytes;
+
+      dev->d_rdndx += nbytes;
+      if (dev->d_rdndx >= dev->d_bufsize)
+        {
+          dev->d_rdndx = 0;
+        }
     }
 
-  /* Notify all poll/select waiters that they can write to the FIFO */
+  /* Notify all poll/select waiters that they can write to the FIFO.  They
+   * can only be waiting if the FIFO was full.
+   */
 
-  pipecommon_pollnotify(dev, POLLOUT);
+  if (wasfull)
+    {
+      pipecommon_pollnotify(dev, POLLOUT);
+    }
 
   /* Notify all waiting writers that bytes have been removed from the
    * buffer.
@@ -504,7 +641,8 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct pipe_dev_s *dev      = inode->i_private;
   ssize_t                nwritten = 0;
   ssize_t                last;
-  int                    nxtwrndx;
+  size_t                 nbytes;
+  bool                   wasempty = false;
   int                    sval;
   int                    ret;
 
@@ -561,33 +699,62 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   last = 0;
   for (; ; )
     {
-      /* Calculate the write index AFTER the next byte is written */
+      /* Remember if the FIFO was empty before this pass */
 
-      nxtwrndx = dev->d_wrndx + 1;
-      if (nxtwrndx >= dev->d_bufsize)
+      if (last == nwritten)
         {
-          nxtwrndx = 0;
+          wasempty = (dev->d_wrndx == dev->d_rdndx);
         }
 
-      /* Would the next write overflow the circular buffer? */
+      /* How many bytes can be copied to the contiguous free space at the
+       * write index?  One byte always stays unused so that a full buffer
+       * can be told from an empty one.
+       */
 
-      if (nxtwrndx != dev->d_rdndx)
+      if (dev->d_wrndx >= dev->d_rdndx)
         {
-          /* No... copy the byte */
+          nbytes = dev->d_bufsize - dev->d_wrndx;
+          if (dev->d_rdndx == 0)
+            {
+              nbytes--;
+            }
+        }
+      else
+        {
+          nbytes = dev->d_rdndx - dev->d_wrndx - 1;
+        }
+
+      if (nbytes > 0)
+        {
+          /* Copy as much as fits */
+
+          if (nbytes > len - nwritten)
+            {
+              nbytes = len - nwritten;
+            }
+
+          memcpy(&dev->d_buffer[dev->d_wrndx], buffer, nbytes);
+          buffer   += nbytes;
+          nwritten += nbytes;
 
-          dev->d_buffer[dev->d_wrndx] = *buffer++;
-          dev->d_wrndx = nxtwrndx;
+          dev->d_wrndx += nbytes;
+          if (dev->d_wrndx >= dev->d_bufsize)
+            {
+              dev->d_wrndx = 0;
+            }
 
           /* Is the write complete? */
 
-          nwritten++;
           if ((size_t)nwritten >= len)
             {
               /* Notify all poll/select waiters that they can read from the
-               * FIFO.
+               * FIFO.  They can only be waiting if the FIFO was empty.
                */
 
-              pipecommon_pollnotify(dev, POLLIN);
+              if (wasempty)
+                {
+                  pipecommon_pollnotify(dev, POLLIN);
+                }
 
               /* Yes.. Notify all of the waiting readers that more data is
                * available.
@@ -616,7 +783,10 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
                * FIFO.
                */
 
-              pipecommon_pollnotify(dev, POLLIN);
+              if (wasempty)
+                {
+                  pipecommon_pollnotify(dev, POLLIN);
+                }
 
               /* Yes.. Notify all of the waiting readers that more data is
                * available.
@@ -835,29 +1005,27 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+      case PIPEIOC_SETSIZE:
+        {
+          ret = pipecommon_resize(dev, (size_t)arg);
+        }
+        break;
+
+      case PIPEIOC_GETSIZE:
+        {
+          ret = dev->d_bufsize;
+        }
+        break;
+
       case FIONWRITE:  /* Number of bytes waiting in send queue */
       case FIONREAD:   /* Number of bytes available for reading */
         {
-          int count;
-
           /* Determine the number of bytes written to the buffer.  This is,
            * of course, also the number of bytes that may be read from the
            * buffer.
-           *
-           *   d_rdndx - index to remove next byte from the buffer
-           *   d_wrndx - Index to next location to add a byte to the buffer.
            */
 
-          if (dev->d_wrndx < dev->d_rdndx)
-            {
-              count = (dev->d_bufsize - dev->d_rdndx) + dev->d_wrndx;
-            }
-          else
-            {
-              count = dev->d_wrndx - dev->d_rdndx;
-            }
-
-          *(FAR int *)((uintptr_t)arg) = count;
+          *(FAR int *)((uintptr_t)arg) = pipecommon_bufferused(dev);
           ret = 0;
         }
         break;
@@ -97,6 +97,8 @@ static int     rd_ioctl(FAR struct inode *inode, int cmd,
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
 static int     rd_unlink(FAR struct inode *inode);
 #endif
+static int     rd_submit(FAR struct inode *inode,
+                 FAR struct blk_request_s *req);
 
 /****************************************************************************
  * Private Data
@@ -116,8 +118,9 @@ static const struct block_operations g_bops =
   rd_geometry, /* geometry */
   rd_ioctl,    /* ioctl    */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
-  rd_unlink    /* unlink   */
+  rd_unlink,   /* unlink   */
 #endif
+  rd_submit    /* submit   */
 };
 
 /****************************************************************************
@@ -387,6 +390,71 @@ static int rd_unlink(FAR struct inode *inode)
 }
 #endif
 
+/****************************************************************************
+ * Name: rd_submit
+ *
+ * Description:
+ *   Perform a scatter/gather request.  The RAM disk never blocks, so the
+ *   request is completed before returning.
+ *
+ ****************************************************************************/
+
+static int rd_submit(FAR struct inode *inode, FAR struct blk_request_s *req)
+{
+  FAR struct rd_struct_s *dev;
+  FAR const struct blk_segment_s *seg;
+  FAR uint8_t *media;
+  blkcnt_t nsectors = 0;
+  size_t nbytes;
+  int i;
+
+  DEBUGASSERT(inode && inode->i_private && req);
+  dev = (FAR struct rd_struct_s *)inode->i_private;
+
+  for (i = 0; i < req->br_nsegs; i++)
+    {
+      nsectors += req->br_segs[i].bs_nsectors;
+    }
+
+  finfo("op: %d sector: %" PRIuOFF " nsectors: %" PRIuOFF " nsegs: %d\n",
+        req->br_op, req->br_sector, nsectors, req->br_nsegs);
+
+  if (req->br_op == BLKREQ_WRITE && !RDFLAG_IS_WRENABLED(dev->rd_flags))
+    {
+      req->br_result = -EACCES;
+    }
+  else if (req->br_sector >= dev->rd_nsectors ||
+           req->br_sector + nsectors > dev->rd_nsectors)
+    {
+      req->br_result = req->br_op == BLKREQ_WRITE ? -EFBIG : -EINVAL;
+    }
+  else
+    {
+      media = &dev->rd_buffer[req->br_sector * dev->rd_sectsize];
+      for (i = 0; i < req->br_nsegs; i++)
+        {
+          seg    = &req->br_segs[i];
+          nbytes = seg->bs_nsectors * dev->rd_sectsize;
+
+          if (req->br_op == BLKREQ_WRITE)
+            {
+              memcpy(media, seg->bs_buffer, nbytes);
+            }
+          else
+            {
+              memcpy(seg->bs_buffer, media, nbytes);
+            }
+
+          media += nbytes;
+        }
+
+      req->br_result = nsectors;
+    }
+
+  req->br_complete(req);
+  return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
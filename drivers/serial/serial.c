@@ -84,6 +84,10 @@ static void    uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset);
 
 static int     uart_putxmitchar(FAR uart_dev_t *dev, int ch,
                                 bool oktoblock);
+static ssize_t uart_putxmitbuf(FAR uart_dev_t *dev, FAR const char *buffer,
+                               size_t buflen, bool oktoblock);
+static size_t  uart_rawlen(FAR uart_dev_t *dev, FAR const char *buffer,
+                           size_t buflen);
 static inline ssize_t uart_irqwrite(FAR uart_dev_t *dev,
                                     FAR const char *buffer,
                                     size_t buflen);
@@ -321,6 +325,114 @@ static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
   return OK;
 }
 
+/****************************************************************************
+ * Name: uart_putxmitbuf
+ *
+ * Description:
+ *   Copy as much of the buffer as fits into the contiguous free space at
+ *   the head of the TX buffer.  If the TX buffer is full, wait for space
+ *   for one character using uart_putxmitchar().
+ *
+ * Returned Value:
+ *   The number of bytes added to the TX buffer (always greater than zero)
+ *   or a negated errno value from uart_putxmitchar().
+ *
+ ****************************************************************************/
+
+static ssize_t uart_putxmitbuf(FAR uart_dev_t *dev, FAR const char *buffer,
+                               size_t buflen, bool oktoblock)
+{
+  int16_t head = dev->xmit.head;
+  int16_t tail = dev->xmit.tail;
+  size_t nbytes;
+  int ret;
+
+  /* One slot always stays unused so that a full buffer can be told from
+   * an empty one.
+   */
+
+  if (head >= tail)
+    {
+      nbytes = dev->xmit.size - head;
+      if (tail == 0)
+        {
+          nbytes--;
+        }
+    }
+  else
+    {
+      nbytes = tail - head - 1;
+    }
+
+  if (nbytes == 0)
+    {
+      ret = uart_putxmitchar(dev, *buffer, oktoblock);
+      return ret < 0 ? ret : 1;
+    }
+
+  if (nbytes > buflen)
+    {
+      nbytes = buflen;
+    }
+
+  memcpy(&dev->xmit.buffer[head], buffer, nbytes);
+
+  head += nbytes;
+  if (head >= dev->xmit.size)
+    {
+      head = 0;
+    }
+
+  dev->xmit.head = head;
+  return nbytes;
+}
+
+/****************************************************************************
+ * Name: uart_rawlen
+ *
+ * Description:
+ *   Return the number of leading bytes of the buffer that need no output
+ *   post-processing and can be copied to the TX buffer as they are.
+ *
+ ****************************************************************************/
+
+static size_t uart_rawlen(FAR uart_dev_t *dev, FAR const char *buffer,
+                          size_t buflen)
+{
+  size_t nbytes;
+
+#ifdef CONFIG_SERIAL_TERMIOS
+  if ((dev->tc_oflag & OPOST) == 0 ||
+      (dev->tc_oflag & (OCRNL | ONLCR | ONLRET)) == 0)
+    {
+      return buflen;
+    }
+
+  for (nbytes = 0; nbytes < buflen; nbytes++)
+    {
+      if (buffer[nbytes] == '\n' || buffer[nbytes] == '\r')
+        {
+          break;
+        }
+    }
+#else
+  if (!dev->isconsole)
+    {
+      return buflen;
+    }
+
+  for (nbytes = 0; nbytes < buflen; nbytes++)
+    {
+      if (buffer[nbytes] == '\n')
+        {
+          break;
+        }
+    }
+#endif
+
+  return nbytes;
+}
+
 /****************************************************************************
  * Name: uart_putc
  ****************************************************************************/
@@ -705,8 +817,12 @@ static ssize_t uart_read(FAR struct file *filep,
 #endif
   irqstate_t flags;
   ssize_t recvd = 0;
+  size_t nbytes;
+  int16_t head;
   int16_t tail;
+#ifdef CONFIG_SERIAL_TERMIOS
   char ch;
+#endif
   int ret;
 
   /* Only one user can access rxbuf->tail at a time */
@@ -757,29 +873,30 @@ static ssize_t uart_read(FAR struct file *filep,
        */
 
       tail = rxbuf->tail;
-      if (rxbuf->head != tail)
+      head = rxbuf->head;
+      if (head != tail)
         {
-          /* Take the next character from the tail of the buffer */
+#ifdef CONFIG_SERIAL_TERMIOS
+          /* Do input processing if any is enabled */
 
-          ch = rxbuf->buffer[tail];
+          if (dev->tc_iflag & (INLCR | IGNCR | ICRNL))
+            {
+              /* Take the next character from the tail of the buffer */
 
-          /* Increment the tail index.  Most operations are done using the
-           * local variable 'tail' so that the final rxbuf->tail update
-           * is atomic.
-           */
+              ch = rxbuf->buffer[tail];
 
-          if (++tail >= rxbuf->size)
-            {
-              tail = 0;
-            }
+              /* Increment the tail index.  Most operations are done using
+               * the local variable 'tail' so that the final rxbuf->tail
+               * update is atomic.
+               */
 
-          rxbuf->tail = tail;
+              if (++tail >= rxbuf->size)
+                {
+                  tail = 0;
+                }
 
-#ifdef CONFIG_SERIAL_TERMIOS
-          /* Do input processing if any is enabled */
+              rxbuf->tail = tail;
 
-          if (dev->tc_iflag & (INLCR | IGNCR | ICRNL))
-            {
               /* \n -> \r or \r -> \n translation? */
 
               if ((ch == '\n') && (dev->tc_iflag & INLCR))
@@ -797,22 +914,47 @@ static ssize_t uart_read(FAR struct file *filep,
                 {
                   continue;
                 }
+
+              /* Specifically not handled:
+               *
+               * All of the local modes; echo, line editing, etc.
+               * Anything to do with break or parity errors.
+               * ISTRIP - we should be 8-bit clean.
+               * IUCLC - Not Posix
+               * IXON/OXOFF - no xon/xoff flow control.
+               */
+
+              /* Store the received character */
+
+              *buffer++ = ch;
+              recvd++;
+              continue;
             }
+#endif
 
-          /* Specifically not handled:
-           *
-           * All of the local modes; echo, line editing, etc.
-           * Anything to do with break or parity errors.
-           * ISTRIP - we should be 8-bit clean.
-           * IUCLC - Not Posix
-           * IXON/OXOFF - no xon/xoff flow control.
+          /* No input processing.  Copy the contiguous data up to the head
+           * or to the end of the buffer in bulk.  Any wrapped data will be
+           * taken on the next time through the loop.
            */
-#endif
 
-          /* Store the received character */
+          nbytes = (head > tail ? head : rxbuf->size) - tail;
+          if (nbytes > buflen - recvd)
+            {
+              nbytes = buflen - recvd;
+            }
+
+          memcpy(buffer, &rxbuf->buffer[tail], nbytes);
 
-          *buffer++ = ch;
-          recvd++;
+          tail += nbytes;
+          if (tail >= rxbuf->size)
+            {
+              tail = 0;
+            }
+
+          rxbuf->tail = tail;
+
+          buffer += nbytes;
+          recvd  += nbytes;
         }
 
 #ifdef CONFIG_DEV_SERIAL_FULLBLOCKS
@@ -1060,6 +1202,7 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct inode *inode    = filep->f_inode;
   FAR uart_dev_t   *dev      = inode->i_private;
   ssize_t           nwritten = buflen;
+  size_t            nraw;
   bool              oktoblock;
   int               ret;
   char              ch;
@@ -1130,56 +1273,83 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
    */
 
   uart_disabletxint(dev);
-  for (; buflen; buflen--)
+  while (buflen > 0)
     {
-      ch  = *buffer++;
-      ret = OK;
-
-#ifdef CONFIG_SERIAL_TERMIOS
-      /* Do output post-processing */
+      /* Copy any run of characters that needs no post-processing to the
+       * transmit buffer in bulk.
+       */
 
-      if ((dev->tc_oflag & OPOST) != 0)
+      nraw = uart_rawlen(dev, buffer, buflen);
+      if (nraw > 0)
         {
-          /* Mapping CR to NL? */
-
-          if ((ch == '\r') && (dev->tc_oflag & OCRNL) != 0)
+          ret = uart_putxmitbuf(dev, buffer, nraw, oktoblock);
+          if (ret > 0)
             {
-              ch = '\n';
+              buffer += ret;
+              buflen -= ret;
+              continue;
             }
+        }
+      else
+        {
+          /* Otherwise, process the next character alone */
 
-          /* Are we interested in newline processing? */
+          ch  = *buffer;
+          ret = OK;
 
-          if ((ch == '\n') && (dev->tc_oflag & (ONLCR | ONLRET)) != 0)
+#ifdef CONFIG_SERIAL_TERMIOS
+          /* Do output post-processing */
+
+          if ((dev->tc_oflag & OPOST) != 0)
             {
-              ret = uart_putxmitchar(dev, '\r', oktoblock);
-            }
+              /* Mapping CR to NL? */
 
-          /* Specifically not handled:
-           *
-           * OXTABS - primarily a full-screen terminal optimization
-           * ONOEOT - Unix interoperability hack
-           * OLCUC  - Not specified by POSIX
-           * ONOCR  - low-speed interactive optimization
-           */
-        }
+              if ((ch == '\r') && (dev->tc_oflag & OCRNL) != 0)
+                {
+                  ch = '\n';
+                }
+
+              /* Are we interested in newline processing? */
+
+              if ((ch == '\n') && (dev->tc_oflag & (ONLCR | ONLRET)) != 0)
+                {
+                  ret = uart_putxmitchar(dev, '\r', oktoblock);
+                }
+
+              /* Specifically not handled:
+               *
+               * OXTABS - primarily a full-screen terminal optimization
+               * ONOEOT - Unix interoperability hack
+               * OLCUC  - Not specified by POSIX
+               * ONOCR  - low-speed interactive optimization
+               */
+            }
 
 #else /* !CONFIG_SERIAL_TERMIOS */
-      /* If this is the console, convert \n -> \r\n */
+          /* If this is the console, convert \n -> \r\n */
 
-      if (dev->isconsole && ch == '\n')
-        {
-          ret = uart_putxmitchar(dev, '\r', oktoblock);
-        }
+          if (dev->isconsole && ch == '\n')
+            {
+              ret = uart_putxmitchar(dev, '\r', oktoblock);
+            }
 #endif
 
-      /* Put the character into the transmit buffer */
+          /* Put the character into the transmit buffer */
 
-      if (ret >= 0)
-        {
-          ret = uart_putxmitchar(dev, ch, oktoblock);
+          if (ret >= 0)
+            {
+              ret = uart_putxmitchar(dev, ch, oktoblock);
+            }
+
+          if (ret >= 0)
+            {
+              buffer++;
+              buflen--;
+              continue;
+            }
         }
 
-      /* uart_putxmitchar() might return an error under one of two
+      /* uart_putxmitchar() might return an error under one of three
        * conditions:  (1) The wait for buffer space might have been
        * interrupted by a signal (ret should be -EINTR), (2) if
        * CONFIG_SERIAL_REMOVABLE is defined, then uart_putxmitchar()
@@ -1187,34 +1357,30 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
        * (with -ENOTCONN), or (3) if O_NONBLOCK is specified, then
        * then uart_putxmitchar() might return -EAGAIN if the output
        * TX buffer is full.
+       *
+       * POSIX requires that we return -1 and errno set if no data was
+       * transferred.  Otherwise, we return the number of bytes in the
+       * interrupted transfer.
        */
 
-      if (ret < 0)
+      if (buflen < (size_t)nwritten)
         {
-          /* POSIX requires that we return -1 and errno set if no data was
-           * transferred.  Otherwise, we return the number of bytes in the
-           * interrupted transfer.
+          /* Some data was transferred.  Return the number of bytes that
+           * were successfully transferred.
            */
 
-          if (buflen < (size_t)nwritten)
-            {
-              /* Some data was transferred.  Return the number of bytes that
-               * were successfully transferred.
-               */
-
-              nwritten -= buflen;
-            }
-          else
-            {
-              /* No data was transferred. Return the negated errno value.
-               * The VFS layer will set the errno value appropriately).
-               */
-
-              nwritten = ret;
-            }
+          nwritten -= buflen;
+        }
+      else
+        {
+          /* No data was transferred. Return the negated errno value.
+           * The VFS layer will set the errno value appropriately).
+           */
 
-          break;
+          nwritten = ret;
         }
+
+      break;
     }
 
   if (dev->xmit.head != dev->xmit.tail)
@@ -224,6 +224,50 @@ int syslog_add_intbuffer(int ch);
 int syslog_flush_intbuffer(bool force);
 #endif
 
+/****************************************************************************
+ * Name: syslog_add_deferred
+ *
+ * Description:
+ *   Append a buffer of SYSLOG output to the deferred buffer and schedule
+ *   the low-priority worker that will write it to the SYSLOG channels.
+ *   The buffer is added entirely or not at all.
+ *
+ * Input Parameters:
+ *   buffer - The buffer containing the data to be output
+ *   buflen - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   On success, buflen is returned.  -ENOSPC is returned if the deferred
+ *   buffer does not have room for the whole buffer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+ssize_t syslog_add_deferred(FAR const char *buffer, size_t buflen);
+#endif
+
+/****************************************************************************
+ * Name: syslog_flush_deferred
+ *
+ * Description:
+ *   Write any output that is pending in the deferred buffer to the SYSLOG
+ *   channels.
+ *
+ * Input Parameters:
+ *   force   - Use the force() method of the channel vs. the write() method.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts may or may not be disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+void syslog_flush_deferred(bool force);
+#endif
+
 /****************************************************************************
  * Name: syslog_putc
  *
@@ -259,6 +303,25 @@ int syslog_putc(int ch);
 
 ssize_t syslog_write(FAR const char *buffer, size_t buflen);
 
+/****************************************************************************
+ * Name: syslog_default_write
+ *
+ * Description:
+ *   Write a buffer directly to all SYSLOG channels, bypassing any deferred
+ *   buffering.
+ *
+ * Input Parameters:
+ *   buffer - The buffer containing the data to be output
+ *   buflen - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   On success, the number of characters written is returned.  A negated
+ *   errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t syslog_default_write(FAR const char *buffer, size_t buflen);
+
 /****************************************************************************
  * Name: syslog_force
  *
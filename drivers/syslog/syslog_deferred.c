@@ -0,0 +1,287 @@
+/****************************************************************************
+ * drivers/syslog/syslog_deferred.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_DEFERRED
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if CONFIG_SYSLOG_DEFERRED_BUFSIZE > 65535
+#  undef  CONFIG_SYSLOG_DEFERRED_BUFSIZE
+#  define CONFIG_SYSLOG_DEFERRED_BUFSIZE 65535
+#endif
+
+/* The deferred buffer is drained in pieces of this size */
+
+#define SYSLOG_DEFERRED_CHUNK 64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure encapsulates the deferred output buffer state */
+
+struct syslog_deferred_s
+{
+  volatile uint16_t sd_inndx;
+  volatile uint16_t sd_outndx;
+  struct work_s sd_work;
+  char sd_buffer[CONFIG_SYSLOG_DEFERRED_BUFSIZE];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syslog_deferred_s g_syslog_deferred;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_remove_deferred
+ *
+ * Description:
+ *   Remove up to 'buflen' bytes of deferred output from the buffer.
+ *
+ * Input Parameters:
+ *   buffer - The location to return the removed data
+ *   buflen - The maximum number of bytes to remove
+ *
+ * Returned Value:
+ *   The number of bytes removed.  Zero is returned if the buffer is empty.
+ *
+ ****************************************************************************/
+
+static size_t syslog_remove_deferred(FAR char *buffer, size_t buflen)
+{
+  irqstate_t flags;
+  uint32_t inndx;
+  uint32_t outndx;
+  size_t nbytes;
+
+  flags  = enter_critical_section();
+
+  inndx  = (uint32_t)g_syslog_deferred.sd_inndx;
+  outndx = (uint32_t)g_syslog_deferred.sd_outndx;
+
+  /* Take only the contiguous data up to the end of the buffer.  Any
+   * wrapped data will be taken by the next call.
+   */
+
+  nbytes = (inndx >= outndx ? inndx : CONFIG_SYSLOG_DEFERRED_BUFSIZE) -
+           outndx;
+  if (nbytes > buflen)
+    {
+      nbytes = buflen;
+    }
+
+  memcpy(buffer, &g_syslog_deferred.sd_buffer[outndx], nbytes);
+
+  outndx += nbytes;
+  if (outndx >= CONFIG_SYSLOG_DEFERRED_BUFSIZE)
+    {
+      outndx -= CONFIG_SYSLOG_DEFERRED_BUFSIZE;
+    }
+
+  g_syslog_deferred.sd_outndx = (uint16_t)outndx;
+  leave_critical_section(flags);
+
+  return nbytes;
+}
+
+/****************************************************************************
+ * Name: syslog_deferred_worker
+ *
+ * Description:
+ *   Drain the deferred buffer to the SYSLOG channels on the low-priority
+ *   work queue.
+ *
+ ****************************************************************************/
+
+static void syslog_deferred_worker(FAR void *arg)
+{
+  syslog_flush_deferred(false);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_add_deferred
+ *
+ * Description:
+ *   Append a buffer of SYSLOG output to the deferred buffer and schedule
+ *   the low-priority worker that will write it to the SYSLOG channels.
+ *   The buffer is added entirely or not at all.
+ *
+ * Input Parameters:
+ *   buffer - The buffer containing the data to be output
+ *   buflen - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   On success, buflen is returned.  -ENOSPC is returned if the deferred
+ *   buffer does not have room for the whole buffer.
+ *
+ ****************************************************************************/
+
+ssize_t syslog_add_deferred(FAR const char *buffer, size_t buflen)
+{
+  irqstate_t flags;
+  uint32_t inndx;
+  uint32_t outndx;
+  size_t inuse;
+  size_t nbytes;
+
+  flags  = enter_critical_section();
+
+  inndx  = (uint32_t)g_syslog_deferred.sd_inndx;
+  outndx = (uint32_t)g_syslog_deferred.sd_outndx;
+
+  inuse  = inndx >= outndx ? inndx - outndx :
+           inndx + CONFIG_SYSLOG_DEFERRED_BUFSIZE - outndx;
+
+  /* One byte always stays unused so that a full buffer can be told from
+   * an empty one.
+   */
+
+  if (inuse + buflen >= CONFIG_SYSLOG_DEFERRED_BUFSIZE)
+    {
+      leave_critical_section(flags);
+      return -ENOSPC;
+    }
+
+  /* Copy the data in at most two pieces:  Up to the end of the buffer and
+   * then the wrapped remainder.
+   */
+
+  nbytes = CONFIG_SYSLOG_DEFERRED_BUFSIZE - inndx;
+  if (nbytes > buflen)
+    {
+      nbytes = buflen;
+    }
+
+  memcpy(&g_syslog_deferred.sd_buffer[inndx], buffer, nbytes);
+  memcpy(g_syslog_deferred.sd_buffer, buffer + nbytes, buflen - nbytes);
+
+  inndx += buflen;
+  if (inndx >= CONFIG_SYSLOG_DEFERRED_BUFSIZE)
+    {
+      inndx -= CONFIG_SYSLOG_DEFERRED_BUFSIZE;
+    }
+
+  g_syslog_deferred.sd_inndx = (uint16_t)inndx;
+
+  /* Schedule the worker unless it is already pending */
+
+  if (work_available(&g_syslog_deferred.sd_work))
+    {
+      work_queue(LPWORK, &g_syslog_deferred.sd_work,
+                 syslog_deferred_worker, NULL, 0);
+    }
+
+  leave_critical_section(flags);
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: syslog_flush_deferred
+ *
+ * Description:
+ *   Write any output that is pending in the deferred buffer to the SYSLOG
+ *   channels.
+ *
+ * Input Parameters:
+ *   force   - Use the force() method of the channel vs. the write() method.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts may or may not be disabled.
+ *
+ ****************************************************************************/
+
+void syslog_flush_deferred(bool force)
+{
+  char chunk[SYSLOG_DEFERRED_CHUNK];
+  size_t nbytes;
+  size_t j;
+  int i;
+
+  /* This logic is performed with the scheduler disabled so that concurrent
+   * flushes from other tasks cannot reorder the output.
+   */
+
+  sched_lock();
+
+  while ((nbytes = syslog_remove_deferred(chunk, sizeof(chunk))) > 0)
+    {
+      if (!force)
+        {
+          syslog_default_write(chunk, nbytes);
+          continue;
+        }
+
+      for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
+        {
+          if (g_syslog_channel[i] == NULL)
+            {
+              break;
+            }
+
+          if (g_syslog_channel[i]->sc_ops->sc_force != NULL)
+            {
+              for (j = 0; j < nbytes; j++)
+                {
+                  g_syslog_channel[i]->sc_ops->sc_force(g_syslog_channel[i],
+                                                        chunk[j]);
+                }
+            }
+        }
+    }
+
+  sched_unlock();
+}
+
+#endif /* CONFIG_SYSLOG_DEFERRED */
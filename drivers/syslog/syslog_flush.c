@@ -74,6 +74,12 @@ int syslog_flush(void)
   syslog_flush_intbuffer(true);
 #endif
 
+#ifdef CONFIG_SYSLOG_DEFERRED
+  /* Flush any output that is still pending in the deferred buffer */
+
+  syslog_flush_deferred(true);
+#endif
+
   for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
     {
       if (g_syslog_channel[i] == NULL)
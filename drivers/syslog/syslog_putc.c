@@ -105,6 +105,12 @@ int syslog_putc(int ch)
       syslog_flush_intbuffer(false);
 #endif
 
+#ifdef CONFIG_SYSLOG_DEFERRED
+      /* Flush any deferred output so that this character stays in order */
+
+      syslog_flush_deferred(false);
+#endif
+
       for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
         {
           if (g_syslog_channel[i] == NULL)
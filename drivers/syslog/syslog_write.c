@@ -34,7 +34,7 @@
 #include "syslog.h"
 
 /****************************************************************************
- * Private Functions
+ * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
@@ -55,7 +55,7 @@
  *
  ****************************************************************************/
 
-static ssize_t syslog_default_write(FAR const char *buffer, size_t buflen)
+ssize_t syslog_default_write(FAR const char *buffer, size_t buflen)
 {
   int i;
   size_t nwritten = 0;
@@ -117,10 +117,6 @@ static ssize_t syslog_default_write(FAR const char *buffer, size_t buflen)
   return nwritten;
 }
 
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
-
 /****************************************************************************
  * Name: syslog_write
  *
@@ -150,5 +146,25 @@ ssize_t syslog_write(FAR const char *buffer, size_t buflen)
     }
 #endif
 
+#ifdef CONFIG_SYSLOG_DEFERRED
+  if (!up_interrupt_context() && !sched_idletask())
+    {
+      /* Leave the output to the low-priority worker if it fits in the
+       * deferred buffer.
+       */
+
+      if (syslog_add_deferred(buffer, buflen) >= 0)
+        {
+          return buflen;
+        }
+
+      /* The deferred buffer is full.  Drain it first so that the output
+       * stays in order, then write this buffer directly.
+       */
+
+      syslog_flush_deferred(false);
+    }
+#endif
+
   return syslog_default_write(buffer, buflen);
 }
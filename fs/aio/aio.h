@@ -186,6 +186,29 @@ void aioc_free(FAR struct aio_container_s *aioc);
 
 FAR struct aio_container_s *aio_contain(FAR struct aiocb *aiocbp);
 
+/****************************************************************************
+ * Name: aio_getdirect
+ *
+ * Description:
+ *   Return the file structure associated with the AIO control block if the
+ *   transfer is performed directly on the calling thread, i.e., the file
+ *   descriptor is non-blocking and does not refer to a file on a mounted
+ *   volume (which do not honor O_NONBLOCK).  Such a transfer never blocks,
+ *   so the worker thread would give the same result.
+ *
+ * Input Parameters:
+ *   aiocbp - The AIO control block pointer
+ *
+ * Returned Value:
+ *   The file structure or NULL if the transfer must be performed on the
+ *   worker thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_AIO_DIRECT
+FAR struct file *aio_getdirect(FAR struct aiocb *aiocbp);
+#endif
+
 /****************************************************************************
  * Name: aioc_decant
  *
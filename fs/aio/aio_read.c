@@ -215,6 +215,10 @@ static void aio_read_worker(FAR void *arg)
 int aio_read(FAR struct aiocb *aiocbp)
 {
   FAR struct aio_container_s *aioc;
+#ifdef CONFIG_FS_AIO_DIRECT
+  FAR struct file *filep;
+  ssize_t nread;
+#endif
   int ret;
 
   DEBUGASSERT(aiocbp);
@@ -225,6 +229,24 @@ int aio_read(FAR struct aiocb *aiocbp)
   aiocbp->aio_result = -EINPROGRESS;
   aiocbp->aio_priv   = NULL;
 
+#ifdef CONFIG_FS_AIO_DIRECT
+  /* If the descriptor is non-blocking, the transfer cannot block, so
+   * perform it on this thread.  The worker would get the same result,
+   * including EAGAIN, after a container and work queue round trip.
+   */
+
+  filep = aio_getdirect(aiocbp);
+  if (filep != NULL)
+    {
+      nread = file_pread(filep, (FAR void *)aiocbp->aio_buf,
+                         aiocbp->aio_nbytes, aiocbp->aio_offset);
+
+      aiocbp->aio_result = nread;
+      aio_signal(getpid(), aiocbp);
+      return OK;
+    }
+#endif
+
   /* Create a container for the AIO control block.  This may cause us to
    * block if there are insufficient resources to satisfy the request.
    */
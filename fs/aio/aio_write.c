@@ -243,6 +243,10 @@ errout:
 int aio_write(FAR struct aiocb *aiocbp)
 {
   FAR struct aio_container_s *aioc;
+#ifdef CONFIG_FS_AIO_DIRECT
+  FAR struct file *filep;
+  ssize_t nwritten;
+#endif
   int ret;
 
   DEBUGASSERT(aiocbp);
@@ -253,6 +257,32 @@ int aio_write(FAR struct aiocb *aiocbp)
   aiocbp->aio_result = -EINPROGRESS;
   aiocbp->aio_priv   = NULL;
 
+#ifdef CONFIG_FS_AIO_DIRECT
+  /* If the descriptor is non-blocking, the transfer cannot block, so
+   * perform it on this thread.  The worker would get the same result,
+   * including EAGAIN, after a container and work queue round trip.
+   */
+
+  filep = aio_getdirect(aiocbp);
+  if (filep != NULL)
+    {
+      if ((filep->f_oflags & O_APPEND) != 0)
+        {
+          nwritten = file_write(filep, (FAR const void *)aiocbp->aio_buf,
+                                aiocbp->aio_nbytes);
+        }
+      else
+        {
+          nwritten = file_pwrite(filep, (FAR const void *)aiocbp->aio_buf,
+                                 aiocbp->aio_nbytes, aiocbp->aio_offset);
+        }
+
+      aiocbp->aio_result = nwritten;
+      aio_signal(getpid(), aiocbp);
+      return OK;
+    }
+#endif
+
   /* Create a container for the AIO control block.  This may cause us to
    * block if there are insufficient resources to satisfy the request.
    */
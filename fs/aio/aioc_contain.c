@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <sched.h>
+#include <fcntl.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -117,6 +118,47 @@ errout:
   return NULL;
 }
 
+/****************************************************************************
+ * Name: aio_getdirect
+ *
+ * Description:
+ *   Return the file structure associated with the AIO control block if the
+ *   transfer is performed directly on the calling thread, i.e., the file
+ *   descriptor is non-blocking and does not refer to a file on a mounted
+ *   volume (which do not honor O_NONBLOCK).  Such a transfer never blocks,
+ *   so the worker thread would give the same result.
+ *
+ * Input Parameters:
+ *   aiocbp - The AIO control block pointer
+ *
+ * Returned Value:
+ *   The file structure or NULL if the transfer must be performed on the
+ *   worker thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_AIO_DIRECT
+FAR struct file *aio_getdirect(FAR struct aiocb *aiocbp)
+{
+  FAR struct file *filep;
+
+  if (fs_getfilep(aiocbp->aio_fildes, &filep) < 0 ||
+      (filep->f_oflags & O_NONBLOCK) == 0 || filep->f_inode == NULL)
+    {
+      return NULL;
+    }
+
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+  if (INODE_IS_MOUNTPT(filep->f_inode))
+    {
+      return NULL;
+    }
+#endif
+
+  return filep;
+}
+#endif
+
 /****************************************************************************
  * Name: aioc_decant
  *
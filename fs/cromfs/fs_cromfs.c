@@ -42,6 +42,7 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/dirent.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/semaphore.h>
 
 #include "cromfs.h"
 
@@ -53,6 +54,10 @@
 
 #define CROMFS_MAX_LINKS 64
 
+#ifndef CONFIG_FS_CROMFS_CACHE_NBLOCKS
+#  define CONFIG_FS_CROMFS_CACHE_NBLOCKS 0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -62,10 +67,37 @@
 struct cromfs_file_s
 {
   FAR const struct cromfs_node_s *ff_node;  /* The open file node */
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS == 0
   uint32_t ff_offset;                       /* Cached block offset (zero means none) */
   uint16_t ff_ulen;                         /* Length of decompressed data in cache */
   FAR uint8_t *ff_buffer;                   /* Cached, decompressed data */
+#endif
+};
+
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+/* This structure describes one decompressed block in the block cache */
+
+struct cromfs_cblock_s
+{
+  uint32_t cb_offset;                       /* Block offset (zero means none) */
+  uint32_t cb_lastuse;                      /* Cache clock at the last access */
+  uint16_t cb_ulen;                         /* Length of decompressed data */
+  FAR uint8_t *cb_buffer;                   /* Decompressed data */
+};
+
+/* The decompressed block cache.  There is only a single CROMFS image so
+ * the cache is shared by all open files of all mounts of that image.
+ */
+
+struct cromfs_cache_s
+{
+  sem_t cc_sem;                             /* Protects the cache */
+  uint32_t cc_clock;                        /* Incremented on each access */
+  unsigned int cc_nmounts;                  /* Number of active mounts */
+  FAR uint8_t *cc_memory;                   /* Memory for all block buffers */
+  struct cromfs_cblock_s cc_blocks[CONFIG_FS_CROMFS_CACHE_NBLOCKS];
 };
+#endif
 
 /* This is the form of the callback from cromfs_foreach_node(): */
 
@@ -118,6 +150,14 @@ static uint16_t cromfs_seglen(FAR const char *relpath);
 static int      cromfs_child_node(FAR const struct cromfs_volume_s *fs,
                   FAR const struct cromfs_node_s *node,
                   FAR struct cromfs_nodeinfo_s *info);
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+static FAR struct cromfs_cblock_s *
+                cromfs_cache_lookup(uint32_t voloffs);
+#endif
+static void     cromfs_copyblock(FAR const struct cromfs_volume_s *fs,
+                  FAR struct cromfs_file_s *ff, FAR const uint8_t *src,
+                  uint16_t clen, uint16_t ulen, unsigned int copyoffs,
+                  unsigned int copysize, FAR uint8_t *dest);
 static int      cromfs_compare_node(FAR const struct cromfs_volume_s *fs,
                   FAR const struct cromfs_node_s *node, uint32_t offset,
                   FAR void *arg);
@@ -210,6 +250,17 @@ const struct mountpt_operations cromfs_operations =
 
 extern const struct cromfs_volume_s g_cromfs_image;
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+static struct cromfs_cache_s g_cromfs_cache =
+{
+  SEM_INITIALIZER(1)
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -490,6 +541,142 @@ static int cromfs_child_node(FAR const struct cromfs_volume_s *fs,
   return OK;
 }
 
+/****************************************************************************
+ * Name: cromfs_cache_lookup
+ *
+ * Description:
+ *   Find the decompressed block with volume offset 'voloffs' in the block
+ *   cache.  If the block is not in the cache, the entry that should be
+ *   replaced is returned instead:  An empty entry or else the least
+ *   recently used one.
+ *
+ * Assumptions:
+ *   The caller holds the cache semaphore.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+static FAR struct cromfs_cblock_s *cromfs_cache_lookup(uint32_t voloffs)
+{
+  FAR struct cromfs_cblock_s *victim = NULL;
+  FAR struct cromfs_cblock_s *cb;
+  uint32_t maxage = 0;
+  uint32_t age;
+  int i;
+
+  g_cromfs_cache.cc_clock++;
+
+  for (i = 0; i < CONFIG_FS_CROMFS_CACHE_NBLOCKS; i++)
+    {
+      cb = &g_cromfs_cache.cc_blocks[i];
+      if (cb->cb_offset == voloffs)
+        {
+          cb->cb_lastuse = g_cromfs_cache.cc_clock;
+          return cb;
+        }
+
+      /* Prefer an empty entry, otherwise the one unused for the longest
+       * time.  The age is computed modulo 2^32 so that wrapping of the
+       * clock is harmless.
+       */
+
+      age = cb->cb_offset == 0 ? UINT32_MAX :
+            g_cromfs_cache.cc_clock - cb->cb_lastuse;
+
+      if (victim == NULL || age > maxage)
+        {
+          victim = cb;
+          maxage = age;
+        }
+    }
+
+  return victim;
+}
+#endif
+
+/****************************************************************************
+ * Name: cromfs_copyblock
+ *
+ * Description:
+ *   Copy 'copysize' bytes, starting 'copyoffs' bytes into the decompressed
+ *   data of the compressed block at 'src', to the user buffer 'dest'.
+ *
+ *   The decompressed block is taken from the cache if it is there.
+ *   Otherwise, if the whole block is wanted, it is decompressed directly
+ *   into the user buffer; if only part of it is wanted, it is decompressed
+ *   into the cache and copied from there.
+ *
+ ****************************************************************************/
+
+static void cromfs_copyblock(FAR const struct cromfs_volume_s *fs,
+                             FAR struct cromfs_file_s *ff,
+                             FAR const uint8_t *src, uint16_t clen,
+                             uint16_t ulen, unsigned int copyoffs,
+                             unsigned int copysize, FAR uint8_t *dest)
+{
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+  FAR struct cromfs_cblock_s *cb;
+#endif
+  uint32_t voloffs;
+
+  DEBUGASSERT((copyoffs + copysize) <= ulen && ulen <= fs->cv_bsize);
+
+  voloffs = cromfs_addr2offset(fs, src);
+
+  finfo("voloffs=%" PRIu32 " ulen=%" PRIu16 " clen=%" PRIu16
+        " copyoffs=%u copysize=%u\n",
+        voloffs, ulen, clen, copyoffs, copysize);
+
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+  nxsem_wait_uninterruptible(&g_cromfs_cache.cc_sem);
+
+  cb = cromfs_cache_lookup(voloffs);
+  if (cb->cb_offset != voloffs)
+    {
+      if (copyoffs == 0 && copysize == ulen)
+        {
+          /* Don't displace a cached block for data that is not needed
+           * again:  Decompress directly into the user buffer.
+           */
+
+          nxsem_post(&g_cromfs_cache.cc_sem);
+          lzf_decompress(src, clen, dest, ulen);
+          return;
+        }
+
+      cb->cb_ulen    = lzf_decompress(src, clen, cb->cb_buffer,
+                                      fs->cv_bsize);
+      cb->cb_offset  = voloffs;
+      cb->cb_lastuse = g_cromfs_cache.cc_clock;
+    }
+
+  DEBUGASSERT(cb->cb_ulen >= (copyoffs + copysize));
+  memcpy(dest, &cb->cb_buffer[copyoffs], copysize);
+
+  nxsem_post(&g_cromfs_cache.cc_sem);
+#else
+  if (voloffs != ff->ff_offset)
+    {
+      if (copyoffs == 0 && copysize == ulen)
+        {
+          /* The whole block is wanted.  Decompress directly into the user
+           * buffer, leaving the file buffer as it is.
+           */
+
+          lzf_decompress(src, clen, dest, ulen);
+          return;
+        }
+
+      ff->ff_ulen   = lzf_decompress(src, clen, ff->ff_buffer,
+                                     fs->cv_bsize);
+      ff->ff_offset = voloffs;
+    }
+
+  DEBUGASSERT(ff->ff_ulen >= (copyoffs + copysize));
+  memcpy(dest, &ff->ff_buffer[copyoffs], copysize);
+#endif
+}
+
 /****************************************************************************
  * Name: cromfs_compare_node
  ****************************************************************************/
@@ -776,6 +963,7 @@ static int cromfs_open(FAR struct file *filep, FAR const char *relpath,
       return -ENOMEM;
     }
 
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS == 0
   /* Create a file buffer to support partial sector accesses */
 
   ff->ff_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
@@ -784,6 +972,7 @@ static int cromfs_open(FAR struct file *filep, FAR const char *relpath,
       kmm_free(ff);
       return -ENOMEM;
     }
+#endif
 
   /* Save the node in the open file instance */
 
@@ -810,11 +999,13 @@ static int cromfs_close(FAR struct file *filep)
   /* Get the open file instance from the file structure */
 
   ff = filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   /* Free all resources consumed by the opened file */
 
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS == 0
   kmm_free(ff->ff_buffer);
+#endif
   kmm_free(ff);
 
   return OK;
@@ -856,7 +1047,7 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   /* Get the open file instance from the file structure */
 
   ff = (FAR struct cromfs_file_s *)filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   /* Check for a read past the end of the file */
 
@@ -961,84 +1152,22 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
         }
       else
         {
-          /* If the source of the data is at the beginning of the compressed
-           * data buffer and if the uncompressed data would not overrun the
-           * buffer, then we can decompress directly into the user buffer.
+          /* Decompress the block, or take it from the cache, and copy the
+           * requested part to the user buffer.
            */
 
-          if (filep->f_pos <= blkoffs && ulen <= remaining)
-            {
-              uint32_t voloffs;
-
-              copyoffs = 0;
-              copysize = ulen;
-
-              /* Get the address and offset in the CROMFS image to obtain
-               * the data.  Check if we already have this offset in the
-               * cache.
-               */
-
-              src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
-                {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, dest, fs->cv_bsize);
-
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
-                }
+          copyoffs = (blkoffs >= filep->f_pos) ? 0 : filep->f_pos - blkoffs;
+          DEBUGASSERT(ulen > copyoffs);
+          copysize = ulen - copyoffs;
 
-              finfo("voloffs=%" PRIu32 " blkoffs=%" PRIu32
-                    " ulen=%" PRIu16 " ff_offset=%" PRIu32 " copysize=%u\n",
-                    voloffs, blkoffs, ulen, ff->ff_offset, copysize);
-              DEBUGASSERT(ff->ff_ulen >= copysize);
-            }
-          else
+          if (copysize > remaining)  /* Clip to the size really needed */
             {
-              uint32_t voloffs;
-
-              /* No, we will need to decompress into the our intermediate
-               * decompression buffer.
-               */
-
-              copyoffs = (blkoffs >= filep->f_pos) ?
-                            0 : filep->f_pos - blkoffs;
-              DEBUGASSERT(ulen > copyoffs);
-              copysize = ulen - copyoffs;
-
-              if (copysize > remaining)  /* Clip to the size really needed */
-                {
-                  copysize = remaining;
-                }
-
-              DEBUGASSERT((copyoffs + copysize) <=  fs->cv_bsize);
-
-              src = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
-                {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, ff->ff_buffer,
-                                             fs->cv_bsize);
-
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
-                }
-
-              finfo("voloffs=%" PRIu32 " blkoffs=%" PRIu32 " ulen=%" PRIu16
-                    " clen=%" PRIu16 " ff_offset=%" PRIu32
-                    "  copyoffs=%u copysize=%u\n",
-                    voloffs, blkoffs, ulen, clen, ff->ff_offset,
-                    copyoffs, copysize);
-              DEBUGASSERT(ff->ff_ulen >= (copyoffs + copysize));
-
-              /* Then copy to user buffer */
-
-              memcpy(dest, &ff->ff_buffer[copyoffs], copysize);
+              copysize = remaining;
             }
+
+          src = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
+          cromfs_copyblock(fs, ff, src, clen, ulen, copyoffs, copysize,
+                           dest);
         }
 
       /* Adjust pointers counts and offset */
@@ -1077,7 +1206,9 @@ static int cromfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
 static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
 {
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS == 0
   FAR struct cromfs_volume_s *fs;
+#endif
   FAR struct cromfs_file_s *oldff;
   FAR struct cromfs_file_s *newff;
 
@@ -1085,15 +1216,17 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
   DEBUGASSERT(oldp->f_priv != NULL && oldp->f_inode != NULL &&
               newp->f_priv == NULL && newp->f_inode != NULL);
 
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS == 0
   /* Recover our private data from the struct file instance */
 
   fs = (FAR struct cromfs_volume_s *)oldp->f_inode->i_private;
   DEBUGASSERT(fs != NULL);
+#endif
 
   /* Get the open file instance from the file structure */
 
   oldff = oldp->f_priv;
-  DEBUGASSERT(oldff->ff_node != NULL && oldff->ff_buffer != NULL);
+  DEBUGASSERT(oldff->ff_node != NULL);
 
   /* Allocate and initialize an new open file instance referring to the
    * same node.
@@ -1105,6 +1238,7 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
       return -ENOMEM;
     }
 
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS == 0
   /* Create a file buffer to support partial sector accesses */
 
   newff->ff_buffer = (FAR uint8_t *)kmm_malloc(fs->cv_bsize);
@@ -1113,6 +1247,7 @@ static int cromfs_dup(FAR const struct file *oldp, FAR struct file *newp)
       kmm_free(newff);
       return -ENOMEM;
     }
+#endif
 
   /* Save the node in the open file instance */
 
@@ -1150,7 +1285,7 @@ static int cromfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
    */
 
   ff              = filep->f_priv;
-  DEBUGASSERT(ff->ff_node != NULL && ff->ff_buffer != NULL);
+  DEBUGASSERT(ff->ff_node != NULL);
 
   inode           = filep->f_inode;
   fs              = inode->i_private;
@@ -1381,6 +1516,38 @@ static int cromfs_bind(FAR struct inode *blkdriver, const void *data,
   DEBUGASSERT(blkdriver == NULL && handle != NULL);
   DEBUGASSERT(g_cromfs_image.cv_magic == CROMFS_MAGIC);
 
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+  /* Allocate the decompressed block cache on the first mount */
+
+  nxsem_wait_uninterruptible(&g_cromfs_cache.cc_sem);
+
+  if (g_cromfs_cache.cc_nmounts == 0)
+    {
+      FAR uint8_t *memory;
+      int i;
+
+      memory = (FAR uint8_t *)
+        kmm_malloc(CONFIG_FS_CROMFS_CACHE_NBLOCKS * g_cromfs_image.cv_bsize);
+      if (memory == NULL)
+        {
+          nxsem_post(&g_cromfs_cache.cc_sem);
+          return -ENOMEM;
+        }
+
+      for (i = 0; i < CONFIG_FS_CROMFS_CACHE_NBLOCKS; i++)
+        {
+          g_cromfs_cache.cc_blocks[i].cb_offset = 0;
+          g_cromfs_cache.cc_blocks[i].cb_buffer =
+            &memory[i * g_cromfs_image.cv_bsize];
+        }
+
+      g_cromfs_cache.cc_memory = memory;
+    }
+
+  g_cromfs_cache.cc_nmounts++;
+  nxsem_post(&g_cromfs_cache.cc_sem);
+#endif
+
   /* Return the new file system handle */
 
   *handle = (FAR void *)&g_cromfs_image;
@@ -1400,6 +1567,22 @@ static int cromfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 {
   finfo("handle: %p blkdriver: %p flags: %02x\n",
         handle, blkdriver, flags);
+
+#if CONFIG_FS_CROMFS_CACHE_NBLOCKS > 0
+  /* Free the decompressed block cache with the last mount */
+
+  nxsem_wait_uninterruptible(&g_cromfs_cache.cc_sem);
+
+  DEBUGASSERT(g_cromfs_cache.cc_nmounts > 0);
+  if (--g_cromfs_cache.cc_nmounts == 0)
+    {
+      kmm_free(g_cromfs_cache.cc_memory);
+      g_cromfs_cache.cc_memory = NULL;
+    }
+
+  nxsem_post(&g_cromfs_cache.cc_sem);
+#endif
+
   return OK;
 }
 
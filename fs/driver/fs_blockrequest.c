@@ -0,0 +1,210 @@
+/****************************************************************************
+ * fs/driver/fs_blockrequest.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <debug.h>
+#include <errno.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/semaphore.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blk_transfer
+ *
+ * Description:
+ *   Perform a request synchronously with the read()/write() methods of the
+ *   block driver, one segment at a time.
+ *
+ ****************************************************************************/
+
+static ssize_t blk_transfer(FAR struct inode *inode,
+                            FAR struct blk_request_s *req)
+{
+  FAR const struct block_operations *bops = inode->u.i_bops;
+  FAR const struct blk_segment_s *seg;
+  blkcnt_t sector = req->br_sector;
+  ssize_t nsectors = 0;
+  ssize_t ret;
+  int i;
+
+  for (i = 0; i < req->br_nsegs; i++)
+    {
+      seg = &req->br_segs[i];
+
+      if (req->br_op == BLKREQ_WRITE)
+        {
+          if (bops->write == NULL)
+            {
+              return -EACCES;
+            }
+
+          ret = bops->write(inode, seg->bs_buffer, sector,
+                            seg->bs_nsectors);
+        }
+      else
+        {
+          ret = bops->read(inode, seg->bs_buffer, sector,
+                           seg->bs_nsectors);
+        }
+
+      if (ret < 0)
+        {
+          return nsectors > 0 ? nsectors : ret;
+        }
+
+      nsectors += ret;
+      sector   += ret;
+
+      /* Stop at the first short transfer */
+
+      if (ret < seg->bs_nsectors)
+        {
+          break;
+        }
+    }
+
+  return nsectors;
+}
+
+/****************************************************************************
+ * Name: blk_wakeup
+ *
+ * Description:
+ *   Completion callback used by blk_request().
+ *
+ ****************************************************************************/
+
+static void blk_wakeup(FAR struct blk_request_s *req)
+{
+  nxsem_post((FAR sem_t *)req->br_priv);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blk_submit
+ *
+ * Description:
+ *   Queue a request on a block driver.  If the driver does not provide the
+ *   submit() method, the request is performed synchronously with the
+ *   read()/write() methods before blk_submit() returns; br_complete() is
+ *   still called in that case.
+ *
+ * Input Parameters:
+ *   inode - reference to the inode of the block driver
+ *   req   - The request to queue.  It must remain valid until
+ *           br_complete() is called.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was queued or performed; a negated errno
+ *   value if it could not be queued.
+ *
+ ****************************************************************************/
+
+int blk_submit(FAR struct inode *inode, FAR struct blk_request_s *req)
+{
+  FAR const struct block_operations *bops;
+
+  if (inode == NULL || req == NULL || req->br_complete == NULL ||
+      (req->br_nsegs > 0 && req->br_segs == NULL))
+    {
+      return -EINVAL;
+    }
+
+  if (!INODE_IS_BLOCK(inode))
+    {
+      return -ENOTBLK;
+    }
+
+  bops = inode->u.i_bops;
+  if (bops == NULL || bops->read == NULL)
+    {
+      return -ENODEV;
+    }
+
+  if (bops->submit != NULL)
+    {
+      return bops->submit(inode, req);
+    }
+
+  req->br_result = blk_transfer(inode, req);
+  req->br_complete(req);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blk_request
+ *
+ * Description:
+ *   Perform a request on a block driver and wait for it to complete.  This
+ *   allows the request interface to be used by code that has no use for
+ *   the asynchronous completion.  br_complete and br_priv are overwritten.
+ *
+ * Input Parameters:
+ *   inode - reference to the inode of the block driver
+ *   req   - The request to perform
+ *
+ * Returned Value:
+ *   The number of sectors transferred or a negated errno value.
+ *
+ ****************************************************************************/
+
+ssize_t blk_request(FAR struct inode *inode, FAR struct blk_request_s *req)
+{
+  sem_t donesem;
+  ssize_t ret;
+
+  if (req == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* The semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&donesem, 0, 0);
+  nxsem_set_protocol(&donesem, SEM_PRIO_NONE);
+
+  req->br_complete = blk_wakeup;
+  req->br_priv     = &donesem;
+
+  ret = blk_submit(inode, req);
+  if (ret >= 0)
+    {
+      nxsem_wait_uninterruptible(&donesem);
+      ret = req->br_result;
+    }
+
+  nxsem_destroy(&donesem);
+  return ret;
+}
@@ -35,9 +35,22 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* SP_DMB() is only provided with CONFIG_SPINLOCK.  Otherwise there is only
+ * one CPU and the volatile accesses below are sufficient.
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -63,7 +76,7 @@ static int _files_semtake(FAR struct filelist *list)
 
 static int files_extend(FAR struct filelist *list, size_t row)
 {
-  FAR struct file **tmp;
+  FAR struct file **files;
   int i;
 
   if (row <= list->fl_rows)
@@ -71,33 +84,55 @@ static int files_extend(FAR struct filelist *list, size_t row)
       return 0;
     }
 
-  tmp = kmm_realloc(list->fl_files, sizeof(FAR struct file *) * row);
-  DEBUGASSERT(tmp);
-  if (tmp == NULL)
+  /* Never realloc the row array in place:  fs_getfilep() may be reading
+   * it concurrently without any lock.  Build a new array and publish it.
+   * The old array may still be in use by a reader, so it is not freed
+   * until files_releaselist().  The slot in front of each array links it
+   * to the array that it replaced.
+   */
+
+  files = kmm_malloc(sizeof(FAR struct file *) * (row + 1));
+  DEBUGASSERT(files);
+  if (files == NULL)
     {
       return -ENFILE;
     }
 
+  files[0] = (FAR struct file *)(list->fl_files ? list->fl_files - 1 : NULL);
+  files++;
+
   i = list->fl_rows;
   do
     {
-      tmp[i] = kmm_zalloc(sizeof(struct file) *
-                          CONFIG_NFILE_DESCRIPTORS_PER_BLOCK);
-      if (tmp[i] == NULL)
+      files[i] = kmm_zalloc(sizeof(struct file) *
+                            CONFIG_NFILE_DESCRIPTORS_PER_BLOCK);
+      if (files[i] == NULL)
         {
           while (--i >= list->fl_rows)
             {
-              kmm_free(tmp[i]);
+              kmm_free(files[i]);
             }
 
-          kmm_free(tmp);
+          kmm_free(files - 1);
           return -ENFILE;
         }
     }
   while (++i < row);
 
-  list->fl_files = tmp;
-  list->fl_rows = row;
+  if (list->fl_rows > 0)
+    {
+      memcpy(files, list->fl_files,
+             sizeof(FAR struct file *) * list->fl_rows);
+    }
+
+  /* Publish the array before the new number of rows, so that a reader
+   * that sees the new number of rows also sees the new array.
+   */
+
+  SP_DMB();
+  *(FAR struct file ** FAR volatile *)&list->fl_files = files;
+  SP_DMB();
+  *(FAR volatile uint8_t *)&list->fl_rows = row;
   return 0;
 }
 
@@ -131,6 +166,8 @@ void files_initlist(FAR struct filelist *list)
 
 void files_releaselist(FAR struct filelist *list)
 {
+  FAR struct file **files;
+  FAR struct file **prev;
   int i;
   int j;
 
@@ -151,7 +188,15 @@ void files_releaselist(FAR struct filelist *list)
       kmm_free(list->fl_files[i]);
     }
 
-  kmm_free(list->fl_files);
+  /* Free the row array and all of the arrays that it replaced */
+
+  files = list->fl_files ? list->fl_files - 1 : NULL;
+  while (files != NULL)
+    {
+      prev = (FAR struct file **)files[0];
+      kmm_free(files);
+      files = prev;
+    }
 
   /* Destroy the semaphore */
 
@@ -331,7 +376,8 @@ out:
 int fs_getfilep(int fd, FAR struct file **filep)
 {
   FAR struct filelist *list;
-  int ret;
+  FAR struct file **files;
+  unsigned int rows;
 
   DEBUGASSERT(filep != NULL);
   *filep = (FAR struct file *)NULL;
@@ -350,26 +396,26 @@ int fs_getfilep(int fd, FAR struct file **filep)
       return -EAGAIN;
     }
 
-  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS_PER_BLOCK * list->fl_rows)
-    {
-      return -EBADF;
-    }
-
-  /* The descriptor is in a valid range to file descriptor... Get the
-   * thread-specific file list.
+  /* No lock is needed:  files_extend() publishes a new row array before
+   * the new number of rows and never frees a row array or a row before
+   * the group exits.  Reading the number of rows first guarantees that
+   * the array read next holds at least that many rows.
    */
 
-  /* And return the file pointer from the list */
+  rows = *(FAR volatile uint8_t *)&list->fl_rows;
+  SP_DMB();
+  files = *(FAR struct file ** FAR volatile *)&list->fl_files;
 
-  ret = _files_semtake(list);
-  if (ret >= 0)
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS_PER_BLOCK * rows)
     {
-      *filep = &list->fl_files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
-                              [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
-      _files_semgive(list);
+      return -EBADF;
     }
 
-  return ret;
+  /* And return the file pointer from the list */
+
+  *filep = &files[fd / CONFIG_NFILE_DESCRIPTORS_PER_BLOCK]
+                 [fd % CONFIG_NFILE_DESCRIPTORS_PER_BLOCK];
+  return OK;
 }
 
 /****************************************************************************
@@ -0,0 +1,162 @@
+/****************************************************************************
+ * fs/mmap/fs_msync.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+
+#include "inode/inode.h"
+#include "fs_rammap.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_msync
+ *
+ * Description:
+ *   Equivalent to the standard msync() function except it does not set
+ *   the errno variable.
+ *
+ ****************************************************************************/
+
+int file_msync(FAR void *addr, size_t length, int flags)
+{
+#ifdef CONFIG_FS_RAMMAP
+  FAR struct fs_rammap_s *curr;
+  uintptr_t start;
+  uintptr_t end;
+  int ret;
+
+  if ((flags & (MS_ASYNC | MS_SYNC)) == (MS_ASYNC | MS_SYNC))
+    {
+      return -EINVAL;
+    }
+
+  ret = nxsem_wait(&g_rammaps.exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Write back every shared region that overlaps the specified range.
+   * The range is not mapped at all if no region overlaps it.
+   */
+
+  ret = -ENOMEM;
+  for (curr = g_rammaps.head; curr; curr = curr->flink)
+    {
+      start = (uintptr_t)curr->addr;
+      end   = start + curr->length;
+
+      if ((uintptr_t)addr >= end || (uintptr_t)addr + length <= start)
+        {
+          continue;
+        }
+
+      if ((uintptr_t)addr > start)
+        {
+          start = (uintptr_t)addr;
+        }
+
+      if ((uintptr_t)addr + length < end)
+        {
+          end = (uintptr_t)addr + length;
+        }
+
+      ret = rammap_writeback(curr, (FAR void *)start, end - start);
+      if (ret >= 0 && (flags & MS_SYNC) != 0 &&
+          (curr->flags & RAMMAP_FLAG_WRITE) != 0)
+        {
+          ret = file_fsync(&curr->file);
+          if (ret == -EINVAL)
+            {
+              /* The file system has no fsync() method */
+
+              ret = OK;
+            }
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  nxsem_post(&g_rammaps.exclsem);
+  return ret;
+#else
+  /* XIP mappings refer directly to the media and cannot be modified */
+
+  return OK;
+#endif /* CONFIG_FS_RAMMAP */
+}
+
+/****************************************************************************
+ * Name: msync
+ *
+ * Description:
+ *   msync() flushes changes made to the in-core copy of a file that was
+ *   mapped into memory using mmap() back to the file.  Only MAP_SHARED
+ *   mappings created with PROT_WRITE under CONFIG_FS_RAMMAP hold a copy
+ *   of the file that may differ from the file content; all other mappings
+ *   are left untouched.
+ *
+ * Input Parameters:
+ *   addr    The start address of the range to flush
+ *   length  The length of the range
+ *   flags   MS_ASYNC or MS_SYNC, optionally ORed with MS_INVALIDATE
+ *
+ * Returned Value:
+ *   On success, msync() returns 0, on failure -1, and errno is set
+ *   appropriately.
+ *
+ ****************************************************************************/
+
+int msync(FAR void *addr, size_t length, int flags)
+{
+  int ret;
+
+  /* msync() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = file_msync(addr, length, flags);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
@@ -106,7 +106,24 @@ static int file_munmap_(FAR void *start, size_t length, bool kernel)
 
   if (length >= curr->length)
     {
-      /* Yes.. remove the mapping from the list */
+      /* Yes.. drop this reference.  A shared region persists until the last
+       * of its users unmaps it.
+       */
+
+      if (--curr->crefs > 0)
+        {
+          goto out_with_semaphore;
+        }
+
+      /* Write back any modifications and remove the mapping from the
+       * list.
+       */
+
+      if ((curr->flags & RAMMAP_FLAG_SHARED) != 0)
+        {
+          rammap_writeback(curr, curr->addr, curr->length);
+          file_close(&curr->file);
+        }
 
       if (prev)
         {
@@ -135,22 +152,34 @@ static int file_munmap_(FAR void *start, size_t length, bool kernel)
 
   else
     {
+      /* Other users of a shared region may still be using the tail */
+
+      if (curr->crefs > 1)
+        {
+          ferr("ERROR: Cannot partially unmap a region with other users\n");
+          ret = -EBUSY;
+          goto errout_with_semaphore;
+        }
+
+      rammap_writeback(curr, start, length);
+
       if (kernel)
         {
-          newaddr = kmm_realloc(curr->addr,
-                               sizeof(struct fs_rammap_s) + length);
+          newaddr = kmm_realloc(curr,
+                                sizeof(struct fs_rammap_s) + offset);
         }
       else
         {
-          newaddr = kumm_realloc(curr->addr,
-                                sizeof(struct fs_rammap_s) + length);
+          newaddr = kumm_realloc(curr,
+                                 sizeof(struct fs_rammap_s) + offset);
         }
 
-      DEBUGASSERT(newaddr == (FAR void *)(curr->addr));
+      DEBUGASSERT(newaddr == (FAR void *)curr);
       UNUSED(newaddr); /* May not be used */
-      curr->length = length;
+      curr->length = offset;
     }
 
+out_with_semaphore:
   nxsem_post(&g_rammaps.exclsem);
   return OK;
 
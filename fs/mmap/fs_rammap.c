@@ -28,12 +28,14 @@
 #include <sys/mman.h>
 
 #include <string.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
 #include <debug.h>
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
 
 #include "inode/inode.h"
 #include "fs_rammap.h"
@@ -51,6 +53,42 @@ struct fs_allmaps_s g_rammaps =
   SEM_INITIALIZER(1)
 };
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rammap_find
+ *
+ * Description:
+ *   Find an existing MAP_SHARED region of the same file with exactly the
+ *   requested offset and length.  Only such a region can be shared:
+ *   munmap() must be able to drop each reference with the length that it
+ *   was mapped with.  The caller must hold g_rammaps.exclsem.
+ *
+ ****************************************************************************/
+
+static FAR struct fs_rammap_s *rammap_find(FAR struct inode *inode,
+                                           size_t length, off_t offset,
+                                           bool kernel)
+{
+  FAR struct fs_rammap_s *map;
+  uint8_t kflag = kernel ? RAMMAP_FLAG_KERNEL : 0;
+
+  for (map = g_rammaps.head; map != NULL; map = map->flink)
+    {
+      if ((map->flags & RAMMAP_FLAG_SHARED) != 0 &&
+          (map->flags & RAMMAP_FLAG_KERNEL) == kflag &&
+          map->file.f_inode == inode && map->offset == offset &&
+          map->length == length && map->crefs < UINT16_MAX)
+        {
+          return map;
+        }
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -66,6 +104,8 @@ struct fs_allmaps_s g_rammaps =
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   prot    See the PROT_* definitions in sys/mman.h
+ *   flags   See the MAP_* definitions in sys/mman.h
  *   kernel  kmm_zalloc or kumm_zalloc
  *   mapped  The pointer to the mapped area
  *
@@ -81,29 +121,47 @@ struct fs_allmaps_s g_rammaps =
  *
  ****************************************************************************/
 
-int rammap(FAR struct file *filep, size_t length,
-           off_t offset, bool kernel, FAR void **mapped)
+int rammap(FAR struct file *filep, size_t length, off_t offset,
+           int prot, int flags, bool kernel, FAR void **mapped)
 {
   FAR struct fs_rammap_s *map;
+  FAR struct file *rdfile;
   FAR uint8_t *alloc;
   FAR uint8_t *rdbuffer;
   ssize_t nread;
   off_t fpos;
   int ret;
 
-  /* There is a major design flaw that I have not yet thought of fix for:
-   * The goal is to have a single region of memory that represents a single
-   * file and can be shared by many threads.  That is, given a filename a
-   * thread should be able to open the file, get a file descriptor, and
-   * call mmap() to get a memory region.  Different file descriptors opened
-   * with the same file path should get the same memory region when mapped.
-   *
-   * The design flaw is that I don't have sufficient knowledge to know that
-   * these different file descriptors map to the same file.  So, for the time
-   * being, a new memory region is created each time that rammap() is called.
-   * Not very useful!
+  ret = nxsem_wait(&g_rammaps.exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Different file descriptors opened on the same file map the same
+   * memory region when MAP_SHARED is requested.  The inode identifies the
+   * file; the region keeps its own reference so the inode cannot be freed
+   * and re-used while the region exists.
    */
 
+  if ((flags & MAP_SHARED) != 0)
+    {
+      map = rammap_find(filep->f_inode, length, offset, kernel);
+      if (map != NULL)
+        {
+          if ((prot & PROT_WRITE) != 0 &&
+              (map->file.f_oflags & O_WROK) != 0)
+            {
+              map->flags |= RAMMAP_FLAG_WRITE;
+            }
+
+          map->crefs++;
+          nxsem_post(&g_rammaps.exclsem);
+          *mapped = map->addr;
+          return OK;
+        }
+    }
+
   /* Allocate a region of memory of the specified size */
 
   alloc = kernel ?
@@ -112,7 +170,8 @@ int rammap(FAR struct file *filep, size_t length,
   if (!alloc)
     {
       ferr("ERROR: Region allocation failed, length: %d\n", (int)length);
-      return -ENOMEM;
+      ret = -ENOMEM;
+      goto errout_with_semaphore;
     }
 
   /* Initialize the region */
@@ -122,10 +181,34 @@ int rammap(FAR struct file *filep, size_t length,
   map->addr   = alloc + sizeof(struct fs_rammap_s);
   map->length = length;
   map->offset = offset;
+  map->crefs  = 1;
+  map->flags  = kernel ? RAMMAP_FLAG_KERNEL : 0;
+  rdfile      = filep;
+
+  if ((flags & MAP_SHARED) != 0)
+    {
+      /* Keep a private open reference to the file.  This is also used to
+       * fill the region so that the caller's file position is unchanged.
+       */
+
+      ret = file_dup2(filep, &map->file);
+      if (ret < 0)
+        {
+          goto errout_with_region;
+        }
+
+      map->flags |= RAMMAP_FLAG_SHARED;
+      if ((prot & PROT_WRITE) != 0 && (filep->f_oflags & O_WROK) != 0)
+        {
+          map->flags |= RAMMAP_FLAG_WRITE;
+        }
+
+      rdfile = &map->file;
+    }
 
   /* Seek to the specified file offset */
 
-  fpos = file_seek(filep, offset, SEEK_SET);
+  fpos = file_seek(rdfile, offset, SEEK_SET);
   if (fpos < 0)
     {
       /* Seek failed... errno has already been set, but EINVAL is probably
@@ -134,7 +217,7 @@ int rammap(FAR struct file *filep, size_t length,
 
       ferr("ERROR: Seek to position %d failed\n", (int)offset);
       ret = fpos;
-      goto errout_with_region;
+      goto errout_with_file;
     }
 
   /* Read the file data into the memory region */
@@ -142,7 +225,7 @@ int rammap(FAR struct file *filep, size_t length,
   rdbuffer = map->addr;
   while (length > 0)
     {
-      nread = file_read(filep, rdbuffer, length);
+      nread = file_read(rdfile, rdbuffer, length);
       if (nread < 0)
         {
           /* Handle the special case where the read was interrupted by a
@@ -157,8 +240,10 @@ int rammap(FAR struct file *filep, size_t length,
                    (int)offset, (int)nread);
 
               ret = nread;
-              goto errout_with_region;
+              goto errout_with_file;
             }
+
+          continue;
         }
 
       /* Check for end of file. */
@@ -180,12 +265,6 @@ int rammap(FAR struct file *filep, size_t length,
 
   /* Add the buffer to the list of regions */
 
-  ret = nxsem_wait(&g_rammaps.exclsem);
-  if (ret < 0)
-    {
-      goto errout_with_region;
-    }
-
   map->flink = g_rammaps.head;
   g_rammaps.head = map;
 
@@ -193,6 +272,12 @@ int rammap(FAR struct file *filep, size_t length,
   *mapped = map->addr;
   return OK;
 
+errout_with_file:
+  if ((map->flags & RAMMAP_FLAG_SHARED) != 0)
+    {
+      file_close(&map->file);
+    }
+
 errout_with_region:
   if (kernel)
     {
@@ -203,7 +288,68 @@ errout_with_region:
       kumm_free(alloc);
     }
 
+errout_with_semaphore:
+  nxsem_post(&g_rammaps.exclsem);
   return ret;
 }
 
+/****************************************************************************
+ * Name: rammap_writeback
+ *
+ * Description:
+ *   Write a portion of a MAP_SHARED, PROT_WRITE region back to the file.
+ *   The caller must hold g_rammaps.exclsem.
+ *
+ * Input Parameters:
+ *   map     The mapped region
+ *   start   The first address in the region to write back
+ *   length  The number of bytes to write back
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int rammap_writeback(FAR struct fs_rammap_s *map, FAR void *start,
+                     size_t length)
+{
+  FAR const uint8_t *wrbuffer = start;
+  ssize_t nwritten;
+  off_t fpos;
+
+  if ((map->flags & RAMMAP_FLAG_WRITE) == 0)
+    {
+      return OK;
+    }
+
+  fpos = file_seek(&map->file,
+                   map->offset + (wrbuffer - (FAR uint8_t *)map->addr),
+                   SEEK_SET);
+  if (fpos < 0)
+    {
+      ferr("ERROR: Seek to position %d failed\n", (int)fpos);
+      return (int)fpos;
+    }
+
+  while (length > 0)
+    {
+      nwritten = file_write(&map->file, wrbuffer, length);
+      if (nwritten < 0)
+        {
+          if (nwritten == -EINTR)
+            {
+              continue;
+            }
+
+          ferr("ERROR: Write failed: %d\n", (int)nwritten);
+          return (int)nwritten;
+        }
+
+      wrbuffer += nwritten;
+      length   -= nwritten;
+    }
+
+  return OK;
+}
+
 #endif /* CONFIG_FS_RAMMAP */
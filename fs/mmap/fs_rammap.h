@@ -28,10 +28,24 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/fs/fs.h>
 #include <nuttx/semaphore.h>
 
 #ifdef CONFIG_FS_RAMMAP
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Values for the fs_rammap_s flags field */
+
+#define RAMMAP_FLAG_KERNEL  (1 << 0)  /* Allocated with kmm_malloc() */
+#define RAMMAP_FLAG_SHARED  (1 << 1)  /* MAP_SHARED, may have several users */
+#define RAMMAP_FLAG_WRITE   (1 << 2)  /* Written back by msync()/munmap() */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -48,9 +62,15 @@
  * - All of the file must be present in memory.  This limits the size of
  *   files that may be memory mapped (especially on MCUs with no significant
  *   RAM resources).
- * - All mapped files are read-only.  You can write to the in-memory image,
- *   but the file contents will not change.
+ * - Changes to the in-memory image only reach the file for MAP_SHARED
+ *   mappings with PROT_WRITE, and only when msync() or the final munmap()
+ *   writes them back.
  * - There are not access privileges.
+ *
+ * MAP_SHARED mappings of the same region of the same file share a single
+ * copy.  The region holds its own open reference to the file so that it
+ * can be identified (and written back) after the caller closes the file
+ * descriptor.
  */
 
 struct fs_rammap_s
@@ -59,6 +79,9 @@ struct fs_rammap_s
   FAR void           *addr;        /* Start of allocated memory */
   size_t              length;      /* Length of region */
   off_t               offset;      /* File offset */
+  struct file         file;        /* Private open file (MAP_SHARED only) */
+  uint16_t            crefs;       /* Number of mmap() references */
+  uint8_t             flags;       /* See RAMMAP_FLAG_* definitions */
 };
 
 /* This structure defines all "mapped" files */
@@ -92,6 +115,8 @@ extern struct fs_allmaps_s g_rammaps;
  *   length  The length of the mapping.  For exception #1 above, this length
  *           ignored:  The entire underlying media is always accessible.
  *   offset  The offset into the file to map
+ *   prot    See the PROT_* definitions in sys/mman.h
+ *   flags   See the MAP_* definitions in sys/mman.h
  *   kernel  kmm_zalloc or kumm_zalloc
  *   mapped  The pointer to the mapped area
  *
@@ -107,8 +132,28 @@ extern struct fs_allmaps_s g_rammaps;
  *
  ****************************************************************************/
 
-int rammap(FAR struct file *filep, size_t length,
-           off_t offset, bool kernel, FAR void **mapped);
+int rammap(FAR struct file *filep, size_t length, off_t offset,
+           int prot, int flags, bool kernel, FAR void **mapped);
+
+/****************************************************************************
+ * Name: rammap_writeback
+ *
+ * Description:
+ *   Write a portion of a MAP_SHARED, PROT_WRITE region back to the file.
+ *   The caller must hold g_rammaps.exclsem.
+ *
+ * Input Parameters:
+ *   map     The mapped region
+ *   start   The first address in the region to write back
+ *   length  The number of bytes to write back
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int rammap_writeback(FAR struct fs_rammap_s *map, FAR void *start,
+                     size_t length);
 
 #endif /* CONFIG_FS_RAMMAP */
 #endif /* __FS_MMAP_RAMMAP_H */
@@ -50,6 +50,15 @@
 
 #include "nfs_proto.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Values for the n_flags field */
+
+#define NFSNODE_UNCOMMITTED (1 << 0) /* UNSTABLE writes not yet committed */
+#define NFSNODE_VERFCHANGED (1 << 1) /* Server write verifier changed */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -70,6 +79,10 @@ struct nfsnode
   struct timespec     n_ctime;      /* File creation time */
   nfsfh_t             n_fhandle;    /* NFS File Handle */
   uint64_t            n_size;       /* Current size of file */
+#ifdef CONFIG_NFS_UNSTABLE_WRITES
+  uint8_t             n_flags;      /* See NFSNODE_* definitions */
+  uint8_t             n_verf[NFSX_V3WRITEVERF]; /* Write verifier */
+#endif
 };
 
 #endif /* __FS_NFS_NFS_NODE_H */
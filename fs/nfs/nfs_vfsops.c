@@ -131,6 +131,10 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
                         size_t buflen);
 static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
                    size_t buflen);
+#ifdef CONFIG_NFS_UNSTABLE_WRITES
+static int     nfs_commit(FAR struct nfsmount *nmp, FAR struct nfsnode *np);
+static int     nfs_sync(FAR struct file *filep);
+#endif
 static int     nfs_dup(FAR const struct file *oldp, FAR struct file *newp);
 static int     nfs_fsinfo(FAR struct nfsmount *nmp);
 static int     nfs_fstat(FAR const struct file *filep, FAR struct stat *buf);
@@ -184,7 +188,11 @@ const struct mountpt_operations nfs_operations =
   NULL,                         /* seek */
   NULL,                         /* ioctl */
 
+#ifdef CONFIG_NFS_UNSTABLE_WRITES
+  nfs_sync,                     /* sync */
+#else
   NULL,                         /* sync */
+#endif
   nfs_dup,                      /* dup */
   nfs_fstat,                    /* fstat */
   nfs_fchstat,                  /* fchstat */
@@ -773,6 +781,9 @@ static int nfs_close(FAR struct file *filep)
   FAR struct nfsnode  *np;
   FAR struct nfsnode  *prev;
   FAR struct nfsnode  *curr;
+#ifdef CONFIG_NFS_UNSTABLE_WRITES
+  int commitret;
+#endif
   int ret;
 
   /* Sanity checks */
@@ -813,6 +824,12 @@ static int nfs_close(FAR struct file *filep)
 
   else
     {
+#ifdef CONFIG_NFS_UNSTABLE_WRITES
+      /* Commit any UNSTABLE writes before forgetting about the file */
+
+      commitret = nfs_commit(nmp, np);
+#endif
+
       /* Assume file structure won't be found. This should never happen. */
 
       ret = -EINVAL;
@@ -843,7 +860,11 @@ static int nfs_close(FAR struct file *filep)
               /* Then deallocate the file structure and return success */
 
               kmm_free(np);
+#ifdef CONFIG_NFS_UNSTABLE_WRITES
+              ret = commitret;
+#else
               ret = OK;
+#endif
               break;
             }
         }
@@ -1048,6 +1069,11 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
   uint32_t               tmp;
   int                    commit = 0;
   int                    committed = NFSV3WRITE_FILESYNC;
+#ifdef CONFIG_NFS_UNSTABLE_WRITES
+  int                    stable = NFSV3WRITE_UNSTABLE;
+#else
+  int                    stable = NFSV3WRITE_FILESYNC;
+#endif
   int                    ret;
 
   finfo("Write %zu bytes to offset %jd\n",
@@ -1129,7 +1155,7 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
       /* Copy the count and stable values */
 
       *ptr++  = txdr_unsigned(writesize);
-      *ptr++  = txdr_unsigned(committed);
+      *ptr++  = txdr_unsigned(stable);
       reqlen += 2*sizeof(uint32_t);
 
       /* Copy a chunk of the user data into the I/O buffer */
@@ -1192,7 +1218,28 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
 
       /* Determine the lowest commitment level obtained by any of the RPCs. */
 
-      commit = *ptr++;
+      commit = fxdr_unsigned(uint32_t, *ptr);
+      ptr++;
+
+#ifdef CONFIG_NFS_UNSTABLE_WRITES
+      /* Remember the write verifier of uncommitted data.  If it changes
+       * before the COMMIT, the server has lost uncommitted data.
+       */
+
+      if (commit == NFSV3WRITE_UNSTABLE)
+        {
+          if ((np->n_flags & NFSNODE_UNCOMMITTED) == 0)
+            {
+              memcpy(np->n_verf, ptr, NFSX_V3WRITEVERF);
+              np->n_flags |= NFSNODE_UNCOMMITTED;
+            }
+          else if (memcmp(np->n_verf, ptr, NFSX_V3WRITEVERF) != 0)
+            {
+              np->n_flags |= NFSNODE_VERFCHANGED;
+            }
+        }
+#endif
+
       if (committed == NFSV3WRITE_FILESYNC)
         {
           committed = commit;
@@ -1215,6 +1262,136 @@ errout_with_semaphore:
   return byteswritten > 0 ? byteswritten : ret;
 }
 
+/****************************************************************************
+ * Name: nfs_commit
+ *
+ * Description:
+ *   Commit all UNSTABLE writes of a file to stable storage on the server.
+ *   The caller must hold the mount structure semaphore.
+ *
+ * Returned Value:
+ *   0 on success; a negated errno value on failure.  -EIO is returned if
+ *   the server lost uncommitted data (the write verifier changed).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NFS_UNSTABLE_WRITES
+static int nfs_commit(FAR struct nfsmount *nmp, FAR struct nfsnode *np)
+{
+  FAR uint32_t *ptr;
+  uint32_t tmp;
+  size_t reqlen;
+  int ret;
+
+  if ((np->n_flags & NFSNODE_UNCOMMITTED) == 0)
+    {
+      return OK;
+    }
+
+  /* Initialize the request */
+
+  ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.commit.commit;
+  reqlen  = 0;
+
+  /* Copy the variable length, file handle */
+
+  *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
+  reqlen += sizeof(uint32_t);
+
+  memcpy(ptr, &np->n_fhandle, np->n_fhsize);
+  reqlen += uint32_alignup(np->n_fhsize);
+  ptr    += uint32_increment(np->n_fhsize);
+
+  /* Commit the whole file:  An offset and count of zero */
+
+  txdr_hyper((uint64_t)0, ptr);
+  ptr    += 2;
+  reqlen += 2*sizeof(uint32_t);
+
+  *ptr    = txdr_unsigned(0);
+  reqlen += sizeof(uint32_t);
+
+  nfs_statistics(NFSPROC_COMMIT);
+  ret = nfs_request(nmp, NFSPROC_COMMIT,
+                    (FAR void *)&nmp->nm_msgbuffer.commit, reqlen,
+                    (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
+  if (ret)
+    {
+      ferr("ERROR: nfs_request failed: %d\n", ret);
+      return ret;
+    }
+
+  /* Get a pointer to the COMMIT reply data and skip over file_wcc */
+
+  ptr = (FAR uint32_t *)
+    &((FAR struct rpc_reply_commit *)nmp->nm_iobuffer)->commit;
+
+  tmp = *ptr++;
+  if (tmp != 0)
+    {
+      ptr += uint32_increment(sizeof(struct wcc_attr));
+    }
+
+  tmp = *ptr++;
+  if (tmp != 0)
+    {
+      nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+      ptr += uint32_increment(sizeof(struct nfs_fattr));
+    }
+
+  /* A different verifier means that the server restarted and discarded
+   * some of the uncommitted data.
+   */
+
+  if ((np->n_flags & NFSNODE_VERFCHANGED) != 0 ||
+      memcmp(np->n_verf, ptr, NFSX_V3WRITEVERF) != 0)
+    {
+      ferr("ERROR: Write verifier changed, uncommitted data lost\n");
+      ret = -EIO;
+    }
+
+  np->n_flags &= ~(NFSNODE_UNCOMMITTED | NFSNODE_VERFCHANGED);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nfs_sync
+ *
+ * Description:
+ *   Commit all UNSTABLE writes of the file to stable storage on the server.
+ *
+ * Returned Value:
+ *   0 on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int nfs_sync(FAR struct file *filep)
+{
+  FAR struct nfsmount *nmp;
+  FAR struct nfsnode  *np;
+  int ret;
+
+  DEBUGASSERT(filep->f_priv != NULL && filep->f_inode != NULL);
+
+  /* Recover our private data from the struct file instance */
+
+  nmp = (FAR struct nfsmount *)filep->f_inode->i_private;
+  np  = (FAR struct nfsnode *)filep->f_priv;
+
+  DEBUGASSERT(nmp != NULL);
+
+  ret = nfs_semtake(nmp);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = nfs_commit(nmp, np);
+  nfs_semgive(nmp);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: nfs_dup
  *
@@ -286,6 +286,12 @@ struct rpc_call_write
 };
 #define SIZEOF_rpc_call_write(n) (sizeof(struct rpc_call_header) + SIZEOF_WRITE3args(n))
 
+struct rpc_call_commit
+{
+  struct rpc_call_header ch;
+  struct COMMIT3args commit;
+};
+
 struct rpc_call_remove
 {
   struct rpc_call_header ch;
@@ -389,6 +395,12 @@ struct rpc_reply_read
 #define SIZEOF_rpc_reply_read(n) \
   (sizeof(struct nfs_reply_header) + SIZEOF_READ3resok(n))
 
+struct rpc_reply_commit
+{
+  struct nfs_reply_header rh;
+  struct COMMIT3resok commit;
+};
+
 struct rpc_reply_remove
 {
   struct nfs_reply_header rh;
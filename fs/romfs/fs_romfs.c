@@ -461,7 +461,10 @@ static ssize_t romfs_read(FAR struct file *filep, FAR char *buffer,
 
           finfo("Return %d bytes from sector offset %d\n",
                 bytesread, sectorndx);
-          memcpy(userbuffer, &rf->rf_buffer[sectorndx], bytesread);
+          memcpy(userbuffer,
+                 &rf->rf_buffer[(sector - rf->rf_cachesector) *
+                                rm->rm_hwsectorsize + sectorndx],
+                 bytesread);
         }
 
       /* Set up for the next sector read */
@@ -1049,10 +1052,7 @@ static int romfs_bind(FAR struct inode *blkdriver, FAR const void *data,
   return OK;
 
 errout_with_buffer:
-  if (!rm->rm_xipbase)
-    {
-      kmm_free(rm->rm_buffer);
-    }
+  romfs_freecache(rm);
 
 errout_with_sem:
   nxsem_destroy(&rm->rm_sem);
@@ -1132,10 +1132,7 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
       /* Release the mountpoint private data */
 
-      if (!rm->rm_xipbase && rm->rm_buffer)
-        {
-          kmm_free(rm->rm_buffer);
-        }
+      romfs_freecache(rm);
 
       nxsem_destroy(&rm->rm_sem);
       kmm_free(rm);
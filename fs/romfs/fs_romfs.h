@@ -38,6 +38,18 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#ifndef CONFIG_FS_ROMFS_CACHE_NBUFFERS
+#  define CONFIG_FS_ROMFS_CACHE_NBUFFERS 1
+#endif
+
+#ifndef CONFIG_FS_ROMFS_CACHE_NSECTORS
+#  define CONFIG_FS_ROMFS_CACHE_NSECTORS 1
+#endif
+
+#ifndef CONFIG_FS_ROMFS_CACHE_NPATHS
+#  define CONFIG_FS_ROMFS_CACHE_NPATHS 0
+#endif
+
 /* Volume header (multi-byte values are big-endian) */
 
 #define ROMFS_VHDR_ROM1FS   0  /*  0-7:  "-rom1fs-" */
@@ -118,6 +130,44 @@
  * Public Types
  ****************************************************************************/
 
+/* This structure describes one buffer of the device sector cache */
+
+struct romfs_cachetag_s
+{
+  uint32_t ct_sector;               /* First sector in the buffer */
+  uint32_t ct_lastuse;              /* Cache clock at the last access */
+  uint16_t ct_nsectors;             /* Sectors in the buffer (0=empty) */
+};
+
+/* This structure is used internally for describing the result of
+ * walking a path
+ */
+
+struct romfs_dirinfo_s
+{
+  /* These values describe the directory containing the terminal
+   * path component (of the terminal component itself if it is
+   * a directory.
+   */
+
+  struct fs_romfsdir_s rd_dir;    /* Describes directory. */
+
+  /* Values from the ROMFS file entry */
+
+  uint32_t rd_next;               /* Offset of the next file header+flags */
+  uint32_t rd_size;               /* Size (if file) */
+};
+
+#if CONFIG_FS_ROMFS_CACHE_NPATHS > 0
+/* This structure holds the result of one successful path lookup */
+
+struct romfs_pathcache_s
+{
+  FAR char *pc_path;                /* Copy of the path (NULL=empty) */
+  struct romfs_dirinfo_s pc_dirinfo; /* Result of the lookup */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a fat32 filesystem.
@@ -137,7 +187,14 @@ struct romfs_mountpt_s
   uint32_t rm_volsize;              /* Size of the ROMFS volume */
   uint32_t rm_cachesector;          /* Current sector in the rm_buffer */
   uint8_t *rm_xipbase;              /* Base address of directly accessible media */
-  uint8_t *rm_buffer;               /* Device sector buffer, allocated if rm_xipbase==0 */
+  uint8_t *rm_buffer;               /* Current sector in rm_cachebase or media */
+  uint8_t *rm_cachebase;            /* Cache buffers, allocated if !rm_xipbase */
+  uint32_t rm_cacheclock;           /* Incremented on each cache lookup */
+  struct romfs_cachetag_s rm_cachetag[CONFIG_FS_ROMFS_CACHE_NBUFFERS];
+#if CONFIG_FS_ROMFS_CACHE_NPATHS > 0
+  uint16_t rm_pathnext;             /* Next path cache entry to replace */
+  struct romfs_pathcache_s rm_pathcache[CONFIG_FS_ROMFS_CACHE_NPATHS];
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -150,30 +207,12 @@ struct romfs_file_s
   FAR struct romfs_file_s *rf_next; /* Retained in a singly linked list */
   uint32_t rf_startoffset;          /* Offset to the start of the file data */
   uint32_t rf_size;                 /* Size of the file in bytes */
-  uint32_t rf_cachesector;          /* Current sector in the rf_buffer */
+  uint32_t rf_cachesector;          /* First sector in the rf_buffer */
+  uint16_t rf_ncachesectors;        /* Number of sectors in the rf_buffer */
   uint8_t *rf_buffer;               /* File sector buffer, allocated if rm_xipbase==0 */
   uint8_t rf_type;                  /* File type (for fstat()) */
 };
 
-/* This structure is used internally for describing the result of
- * walking a path
- */
-
-struct romfs_dirinfo_s
-{
-  /* These values describe the directory containing the terminal
-   * path component (of the terminal component itself if it is
-   * a directory.
-   */
-
-  struct fs_romfsdir_s rd_dir;    /* Describes directory. */
-
-  /* Values from the ROMFS file entry */
-
-  uint32_t rd_next;               /* Offset of the next file header+flags */
-  uint32_t rd_size;               /* Size (if file) */
-};
-
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -198,6 +237,7 @@ int  romfs_hwread(FAR struct romfs_mountpt_s *rm, FAR uint8_t *buffer,
 int  romfs_filecacheread(FAR struct romfs_mountpt_s *rm,
        FAR struct romfs_file_s *rf, uint32_t sector);
 int  romfs_hwconfigure(FAR struct romfs_mountpt_s *rm);
+void romfs_freecache(FAR struct romfs_mountpt_s *rm);
 int  romfs_fsconfigure(FAR struct romfs_mountpt_s *rm);
 int  romfs_fileconfigure(FAR struct romfs_mountpt_s *rm,
        FAR struct romfs_file_s *rf);
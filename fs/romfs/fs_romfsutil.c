@@ -154,6 +154,104 @@ static inline int romfs_checkentry(struct romfs_mountpt_s *rm,
   return -ENOENT;
 }
 
+/****************************************************************************
+ * Name: romfs_groupsectors
+ *
+ * Description:
+ *   Return the first sector of the read-ahead group containing 'sector' and
+ *   the number of sectors in that group that exist on the device.
+ *
+ ****************************************************************************/
+
+static uint32_t romfs_groupsectors(FAR struct romfs_mountpt_s *rm,
+                                   uint32_t sector, FAR uint16_t *nsectors)
+{
+  uint32_t first;
+
+  first     = sector - sector % CONFIG_FS_ROMFS_CACHE_NSECTORS;
+  *nsectors = CONFIG_FS_ROMFS_CACHE_NSECTORS;
+
+  if (rm->rm_hwnsectors > first && first + *nsectors > rm->rm_hwnsectors)
+    {
+      *nsectors = rm->rm_hwnsectors - first;
+    }
+
+  return first;
+}
+
+/****************************************************************************
+ * Name: romfs_devcachefill
+ *
+ * Description:
+ *   Make rm->rm_buffer refer to the specified sector in the device cache,
+ *   reading the sector and the rest of its read-ahead group into the least
+ *   recently used cache buffer if it is not already cached.  Only used in
+ *   the non-XIP mode.
+ *
+ ****************************************************************************/
+
+static int romfs_devcachefill(FAR struct romfs_mountpt_s *rm,
+                              uint32_t sector)
+{
+  FAR struct romfs_cachetag_s *victim = NULL;
+  FAR struct romfs_cachetag_s *ct;
+  FAR uint8_t *buffer;
+  size_t bufsize;
+  uint32_t maxage = 0;
+  uint32_t age;
+  int ret;
+  int i;
+
+  bufsize = (size_t)CONFIG_FS_ROMFS_CACHE_NSECTORS * rm->rm_hwsectorsize;
+  rm->rm_cacheclock++;
+
+  for (i = 0; i < CONFIG_FS_ROMFS_CACHE_NBUFFERS; i++)
+    {
+      ct = &rm->rm_cachetag[i];
+      if (sector - ct->ct_sector < ct->ct_nsectors)
+        {
+          /* The sector is already in this buffer */
+
+          ct->ct_lastuse = rm->rm_cacheclock;
+          rm->rm_buffer  = rm->rm_cachebase + i * bufsize +
+                           (sector - ct->ct_sector) * rm->rm_hwsectorsize;
+          return OK;
+        }
+
+      /* Prefer an empty buffer, otherwise the one unused for the longest
+       * time.
+       */
+
+      age = ct->ct_nsectors == 0 ? UINT32_MAX :
+            rm->rm_cacheclock - ct->ct_lastuse;
+
+      if (victim == NULL || age > maxage)
+        {
+          victim = ct;
+          maxage = age;
+        }
+    }
+
+  /* Read the whole group containing the sector into the victim buffer */
+
+  buffer = rm->rm_cachebase + (victim - rm->rm_cachetag) * bufsize;
+
+  victim->ct_sector   = romfs_groupsectors(rm, sector,
+                                           &victim->ct_nsectors);
+  victim->ct_lastuse  = rm->rm_cacheclock;
+
+  ret = romfs_hwread(rm, buffer, victim->ct_sector, victim->ct_nsectors);
+  if (ret < 0)
+    {
+      victim->ct_nsectors = 0;
+      return ret;
+    }
+
+  rm->rm_buffer = buffer +
+                  (sector - victim->ct_sector) * rm->rm_hwsectorsize;
+  return OK;
+}
+
 /****************************************************************************
  * Name: romfs_devcacheread
  *
@@ -188,9 +286,11 @@ int16_t romfs_devcacheread(struct romfs_mountpt_s *rm, uint32_t offset)
         }
       else
         {
-          /* In non-XIP mode, we will have to read the new sector. */
+          /* In non-XIP mode, we will have to find the sector in the device
+           * cache or read it.
+           */
 
-          ret = romfs_hwread(rm, rm->rm_buffer, sector, 1);
+          ret = romfs_devcachefill(rm, sector);
           if (ret < 0)
             {
               return (int16_t)ret;
@@ -328,6 +428,73 @@ static inline int romfs_searchdir(struct romfs_mountpt_s *rm,
   return -ENOENT;
 }
 
+/****************************************************************************
+ * Name: romfs_pathcachefind
+ *
+ * Description:
+ *   Look up the result of an earlier successful romfs_finddirentry() of the
+ *   same path.  Returns true and the result in dirinfo on a hit.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_ROMFS_CACHE_NPATHS > 0
+static bool romfs_pathcachefind(FAR struct romfs_mountpt_s *rm,
+                                FAR struct romfs_dirinfo_s *dirinfo,
+                                FAR const char *path)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_ROMFS_CACHE_NPATHS; i++)
+    {
+      FAR struct romfs_pathcache_s *pc = &rm->rm_pathcache[i];
+
+      if (pc->pc_path != NULL && strcmp(pc->pc_path, path) == 0)
+        {
+          memcpy(dirinfo, &pc->pc_dirinfo, sizeof(struct romfs_dirinfo_s));
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: romfs_pathcacheadd
+ *
+ * Description:
+ *   Remember the result of a successful romfs_finddirentry(), replacing the
+ *   entries in round-robin order.  Failure to allocate the copy of the path
+ *   is not an error; the result is simply not cached.
+ *
+ ****************************************************************************/
+
+static void romfs_pathcacheadd(FAR struct romfs_mountpt_s *rm,
+                               FAR const struct romfs_dirinfo_s *dirinfo,
+                               FAR const char *path)
+{
+  FAR struct romfs_pathcache_s *pc;
+  size_t len = strlen(path) + 1;
+
+  pc = &rm->rm_pathcache[rm->rm_pathnext];
+  if (++rm->rm_pathnext >= CONFIG_FS_ROMFS_CACHE_NPATHS)
+    {
+      rm->rm_pathnext = 0;
+    }
+
+  if (pc->pc_path != NULL)
+    {
+      kmm_free(pc->pc_path);
+    }
+
+  pc->pc_path = (FAR char *)kmm_malloc(len);
+  if (pc->pc_path != NULL)
+    {
+      memcpy(pc->pc_path, path, len);
+      memcpy(&pc->pc_dirinfo, dirinfo, sizeof(struct romfs_dirinfo_s));
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -422,12 +589,12 @@ int romfs_filecacheread(struct romfs_mountpt_s *rm, struct romfs_file_s *rf,
         sector, rf->rf_cachesector, rm->rm_hwsectorsize,
         rm->rm_xipbase, rf->rf_buffer);
 
-  /* rf->rf_cachesector holds the current sector that is buffer in or
-   * referenced by rf->rf_buffer. If the requested sector is the same as this
-   * sector then we do nothing.
+  /* rf->rf_cachesector holds the first of the rf->rf_ncachesectors sectors
+   * that are buffered in or referenced by rf->rf_buffer. If the requested
+   * sector is one of these then we do nothing.
    */
 
-  if (rf->rf_cachesector != sector)
+  if (sector - rf->rf_cachesector >= rf->rf_ncachesectors)
     {
       /* Check the access mode */
 
@@ -437,25 +604,31 @@ int romfs_filecacheread(struct romfs_mountpt_s *rm, struct romfs_file_s *rf,
            * address space.
            */
 
-          rf->rf_buffer = rm->rm_xipbase + sector * rm->rm_hwsectorsize;
+          rf->rf_buffer        = rm->rm_xipbase +
+                                 sector * rm->rm_hwsectorsize;
+          rf->rf_cachesector   = sector;
+          rf->rf_ncachesectors = 1;
           finfo("XIP buffer: %p\n", rf->rf_buffer);
         }
       else
         {
-          /* In non-XIP mode, we will have to read the new sector. */
+          /* In non-XIP mode, we will have to read the new sector together
+           * with the rest of its read-ahead group.
+           */
+
+          rf->rf_cachesector = romfs_groupsectors(rm, sector,
+                                                  &rf->rf_ncachesectors);
 
           finfo("Calling romfs_hwread\n");
-          ret = romfs_hwread(rm, rf->rf_buffer, sector, 1);
+          ret = romfs_hwread(rm, rf->rf_buffer, rf->rf_cachesector,
+                             rf->rf_ncachesectors);
           if (ret < 0)
             {
               ferr("ERROR: romfs_hwread failed: %d\n", ret);
+              rf->rf_ncachesectors = 0;
               return ret;
             }
         }
-
-      /* Update the cached sector number */
-
-      rf->rf_cachesector = sector;
     }
 
   return OK;
@@ -554,17 +727,52 @@ int romfs_hwconfigure(struct romfs_mountpt_s *rm)
       return OK;
     }
 
-  /* Allocate the device cache buffer for normal sector accesses */
+  /* Allocate the device cache buffers for normal sector accesses */
 
-  rm->rm_buffer = (FAR uint8_t *)kmm_malloc(rm->rm_hwsectorsize);
-  if (!rm->rm_buffer)
+  rm->rm_cachebase = (FAR uint8_t *)
+    kmm_malloc((size_t)CONFIG_FS_ROMFS_CACHE_NBUFFERS *
+               CONFIG_FS_ROMFS_CACHE_NSECTORS * rm->rm_hwsectorsize);
+  if (!rm->rm_cachebase)
     {
       return -ENOMEM;
     }
 
+  rm->rm_buffer = rm->rm_cachebase;
   return OK;
 }
 
+/****************************************************************************
+ * Name: romfs_freecache
+ *
+ * Description:
+ *   Free the device cache buffers and the path cache of a mountpoint.
+ *   This is the counterpart of romfs_hwconfigure() when the mountpoint is
+ *   destroyed.
+ *
+ ****************************************************************************/
+
+void romfs_freecache(struct romfs_mountpt_s *rm)
+{
+#if CONFIG_FS_ROMFS_CACHE_NPATHS > 0
+  int i;
+
+  for (i = 0; i < CONFIG_FS_ROMFS_CACHE_NPATHS; i++)
+    {
+      if (rm->rm_pathcache[i].pc_path != NULL)
+        {
+          kmm_free(rm->rm_pathcache[i].pc_path);
+          rm->rm_pathcache[i].pc_path = NULL;
+        }
+    }
+#endif
+
+  if (!rm->rm_xipbase && rm->rm_cachebase)
+    {
+      kmm_free(rm->rm_cachebase);
+      rm->rm_cachebase = NULL;
+    }
+}
+
 /****************************************************************************
  * Name: romfs_fsconfigure
  *
@@ -633,18 +841,22 @@ int romfs_fileconfigure(struct romfs_mountpt_s *rm, struct romfs_file_s *rf)
     {
       /* We'll put a valid address in rf_buffer just in case. */
 
-      rf->rf_cachesector = 0;
-      rf->rf_buffer      = rm->rm_xipbase;
+      rf->rf_cachesector   = 0;
+      rf->rf_ncachesectors = 1;
+      rf->rf_buffer        = rm->rm_xipbase;
     }
   else
     {
       /* Nothing in the cache buffer */
 
-      rf->rf_cachesector = (uint32_t)-1;
+      rf->rf_cachesector   = 0;
+      rf->rf_ncachesectors = 0;
 
       /* Create a file buffer to support partial sector accesses */
 
-      rf->rf_buffer = (FAR uint8_t *)kmm_malloc(rm->rm_hwsectorsize);
+      rf->rf_buffer = (FAR uint8_t *)
+        kmm_malloc((size_t)CONFIG_FS_ROMFS_CACHE_NSECTORS *
+                   rm->rm_hwsectorsize);
       if (!rf->rf_buffer)
         {
           return -ENOMEM;
@@ -735,6 +947,15 @@ int romfs_finddirentry(struct romfs_mountpt_s *rm,
       return OK;
     }
 
+#if CONFIG_FS_ROMFS_CACHE_NPATHS > 0
+  /* Has the same path been looked up before? */
+
+  if (romfs_pathcachefind(rm, dirinfo, path))
+    {
+      return OK;
+    }
+#endif
+
   /* Then loop for each directory/file component in the full path */
 
   entryname    = path;
@@ -760,7 +981,7 @@ int romfs_finddirentry(struct romfs_mountpt_s *rm,
 
       if (entrylen == 0)
         {
-          return OK;
+          break;
         }
 
       /* Long path segment names will be truncated to NAME_MAX */
@@ -786,7 +1007,7 @@ int romfs_finddirentry(struct romfs_mountpt_s *rm,
         {
           /* Yes.. return success */
 
-          return OK;
+          break;
         }
 
       /* No... If that was not the last path component, then it had
@@ -805,7 +1026,11 @@ int romfs_finddirentry(struct romfs_mountpt_s *rm,
       entryname = terminator;
     }
 
-  return ERROR; /* Won't get here */
+#if CONFIG_FS_ROMFS_CACHE_NPATHS > 0
+  romfs_pathcacheadd(rm, dirinfo, path);
+#endif
+
+  return OK;
 }
 
 /****************************************************************************
@@ -837,6 +837,10 @@ static size_t smartfs_status_read(FAR struct file *filep, FAR char *buffer,
                          "Sectors Per Block: %d\nSector Utilization:%d%%\n"
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
                          "Uneven Wear Count: %" PRIu32 "\n"
+#endif
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+                         "Map Cache Hits:    %" PRIu32 "\n"
+                         "Map Cache Misses:  %" PRIu32 "\n"
 #endif
                   ,
                   procfs_data.formatversion, procfs_data.namelen,
@@ -847,6 +851,9 @@ static size_t smartfs_status_read(FAR struct file *filep, FAR char *buffer,
                   procfs_data.sectorsperblk, utilization
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
                   , procfs_data.uneven_wearcount
+#endif
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+                  , procfs_data.cachehits, procfs_data.cachemisses
 #endif
            );
         }
@@ -221,6 +221,26 @@ static int file_vfcntl(FAR struct file *filep, int cmd, va_list ap)
         ret = -ENOSYS; /* Not implemented */
         break;
 
+      case F_SETPIPE_SZ:
+        /* Change the size of the buffer of the pipe or FIFO referred to
+         * by fd to arg bytes.  Returns the new size.
+         */
+
+        {
+          ret = file_ioctl(filep, PIPEIOC_SETSIZE, va_arg(ap, int));
+        }
+        break;
+
+      case F_GETPIPE_SZ:
+        /* Return the size of the buffer of the pipe or FIFO referred to
+         * by fd.
+         */
+
+        {
+          ret = file_ioctl(filep, PIPEIOC_GETSIZE, 0);
+        }
+        break;
+
       case F_GETPATH:
         /* Get the path of the file descriptor. The argument must be a buffer
          * of size PATH_MAX or greater.
@@ -96,6 +96,8 @@
 #define F_SETOWN    13 /* Set pid that will receive SIGIO and SIGURG signals for fd */
 #define F_SETSIG    14 /* Set the signal to be sent */
 #define F_GETPATH   15 /* Get the path of the file descriptor(BSD/macOS) */
+#define F_SETPIPE_SZ 16 /* Set the size of the pipe buffer (linux) */
+#define F_GETPIPE_SZ 17 /* Get the size of the pipe buffer (linux) */
 
 /* For posix fcntl() and lockf() */
 
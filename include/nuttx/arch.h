@@ -521,6 +521,33 @@ void up_assert(FAR const char *filename, int linenum);
 int up_backtrace(FAR struct tcb_s *tcb, FAR void **buffer, int size);
 #endif /* CONFIG_ARCH_HAVE_BACKTRACE */
 
+/****************************************************************************
+ * Name: up_interrupted_backtrace
+ *
+ * Description:
+ *  up_interrupted_backtrace() returns a backtrace of the context that was
+ *  interrupted by the interrupt handler that is currently executing.
+ *  Unlike up_backtrace(), the frames of the interrupt handler itself are
+ *  not included:  The first address returned is the address at which the
+ *  interrupted context will resume.
+ *
+ * Input Parameters:
+ *   buffer - Return address from the corresponding stack frame
+ *   size   - Maximum number of addresses that can be stored in buffer
+ *
+ * Returned Value:
+ *   up_interrupted_backtrace() returns the number of addresses returned in
+ *   buffer
+ *
+ * Assumptions:
+ *   Called only from interrupt level.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_INTERRUPTED_BACKTRACE
+int up_interrupted_backtrace(FAR void **buffer, int size);
+#endif
+
 /****************************************************************************
  * Name: up_schedule_sigaction
  *
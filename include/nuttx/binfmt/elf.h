@@ -100,6 +100,10 @@ struct elf_loadinfo_s
 #endif
   size_t            datasize;    /* Size of the ELF .bss/.data memory allocation */
   off_t             filelen;     /* Length of the entire ELF file */
+#ifdef CONFIG_ELF_XIP
+  uintptr_t         xipbase;     /* Address of the file in XIP memory (or 0) */
+  uintptr_t         textbase;    /* Address of the first read-only section */
+#endif
 
   Elf_Ehdr          ehdr;        /* Buffered ELF file header */
   FAR Elf_Shdr      *shdr;       /* Buffered ELF section headers */
@@ -129,6 +133,11 @@ struct elf_loadinfo_s
   save_addrenv_t     oldenv;     /* Saved address environment */
 #endif
 
+#ifdef CONFIG_ELF_LOADSYMTAB
+  FAR Elf_Sym       *symtab;     /* Symbol table read into memory */
+  FAR char          *strtab;     /* String table read into memory */
+#endif
+
   uint16_t           symtabidx;  /* Symbol table section index */
   uint16_t           strtabidx;  /* String table section index */
   uint16_t           buflen;     /* size of iobuffer[] */
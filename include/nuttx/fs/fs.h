@@ -238,6 +238,40 @@ struct partition_info_s
   char            parent[NAME_MAX + 1];
 };
 
+/* A block driver request transfers a run of consecutive sectors, starting
+ * at br_sector, to or from a list of memory segments (scatter/gather).  The
+ * request is queued with the optional submit() method of the block driver
+ * (or with blk_submit(), which emulates it using read()/write()).  When the
+ * transfer completes, br_result holds the number of sectors transferred
+ * or a negated errno value and br_complete() is called.  br_complete() may
+ * be called from the worker thread or interrupt handler of the driver, or
+ * even before submit() returns.
+ */
+
+#define BLKREQ_READ  0 /* Transfer from the device to the segments */
+#define BLKREQ_WRITE 1 /* Transfer from the segments to the device */
+
+struct blk_segment_s
+{
+  FAR unsigned char *bs_buffer;    /* Start of the segment buffer */
+  unsigned int       bs_nsectors;  /* Number of sectors in the segment */
+};
+
+struct blk_request_s;
+typedef CODE void (*blk_complete_t)(FAR struct blk_request_s *req);
+
+struct blk_request_s
+{
+  FAR struct blk_request_s       *br_flink;    /* Driver queue link */
+  FAR const struct blk_segment_s *br_segs;     /* Array of segments */
+  blkcnt_t                        br_sector;   /* First sector */
+  uint8_t                         br_op;       /* See BLKREQ_* */
+  uint8_t                         br_nsegs;    /* Number of segments */
+  ssize_t                         br_result;   /* Sectors or -errno */
+  blk_complete_t                  br_complete; /* Completion callback */
+  FAR void                       *br_priv;     /* br_complete() data */
+};
+
 /* This structure is provided by block devices when they register with the
  * system.  It is used by file systems to perform filesystem transfers.  It
  * differs from the normal driver vtable in several ways -- most notably in
@@ -259,6 +293,13 @@ struct block_operations
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   int     (*unlink)(FAR struct inode *inode);
 #endif
+
+  /* Optional.  Queue a request and return without waiting for it to
+   * complete.  A negated errno value is returned if the request could not
+   * be queued (br_complete() is not called in that case).
+   */
+
+  int     (*submit)(FAR struct inode *inode, FAR struct blk_request_s *req);
 };
 
 /* This structure is provided by a filesystem to describe a mount point.
@@ -414,7 +455,7 @@ struct file
 
 struct filelist
 {
-  sem_t             fl_sem;     /* Manage access to the file list */
+  sem_t             fl_sem;     /* Serialize allocation, close, dup and growth */
   uint8_t           fl_rows;    /* The number of rows of fl_files array */
   FAR struct file **fl_files;   /* The pointer of two layer file descriptors array */
 };
@@ -973,6 +1014,47 @@ int open_blockdriver(FAR const char *pathname, int mountflags,
 
 int close_blockdriver(FAR struct inode *inode);
 
+/****************************************************************************
+ * Name: blk_submit
+ *
+ * Description:
+ *   Queue a request on a block driver.  If the driver does not provide the
+ *   submit() method, the request is performed synchronously with the
+ *   read()/write() methods before blk_submit() returns; br_complete() is
+ *   still called in that case.
+ *
+ * Input Parameters:
+ *   inode - reference to the inode of the block driver
+ *   req   - The request to queue.  It must remain valid until
+ *           br_complete() is called.
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was queued or performed; a negated errno
+ *   value if it could not be queued.
+ *
+ ****************************************************************************/
+
+int blk_submit(FAR struct inode *inode, FAR struct blk_request_s *req);
+
+/****************************************************************************
+ * Name: blk_request
+ *
+ * Description:
+ *   Perform a request on a block driver and wait for it to complete.  This
+ *   allows the request interface to be used by code that has no use for
+ *   the asynchronous completion.  br_complete and br_priv are overwritten.
+ *
+ * Input Parameters:
+ *   inode - reference to the inode of the block driver
+ *   req   - The request to perform
+ *
+ * Returned Value:
+ *   The number of sectors transferred or a negated errno value.
+ *
+ ****************************************************************************/
+
+ssize_t blk_request(FAR struct inode *inode, FAR struct blk_request_s *req);
+
 /****************************************************************************
  * Name: fs_fdopen
  *
@@ -1185,6 +1267,17 @@ off_t nx_seek(int fd, off_t offset, int whence);
 int file_fsync(FAR struct file *filep);
 #endif
 
+/****************************************************************************
+ * Name: file_msync
+ *
+ * Description:
+ *   Equivalent to the standard msync() function except it does not set
+ *   the errno variable.
+ *
+ ****************************************************************************/
+
+int file_msync(FAR void *addr, size_t length, int flags);
+
 /****************************************************************************
  * Name: file_truncate
  *
@@ -405,6 +405,13 @@
                                              *       (default)
                                              *     1=fre when empty
                                              * OUT: None */
+#define PIPEIOC_SETSIZE   _PIPEIOC(0x0002)  /* Set the buffer size
+                                             * IN: unsigned long integer
+                                             *     new size in bytes
+                                             * OUT: None */
+#define PIPEIOC_GETSIZE   _PIPEIOC(0x0003)  /* Get the buffer size
+                                             * IN: None
+                                             * OUT: None */
 
 /* RTC driver ioctl definitions *********************************************/
 
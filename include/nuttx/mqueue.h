@@ -43,6 +43,15 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The largest message that can be sent on any message queue */
+
+#if defined(CONFIG_MQ_MAXDYNMSGSIZE) && \
+    CONFIG_MQ_MAXDYNMSGSIZE > CONFIG_MQ_MAXMSGSIZE
+#  define MQ_MAX_MSGSIZE CONFIG_MQ_MAXDYNMSGSIZE
+#else
+#  define MQ_MAX_MSGSIZE CONFIG_MQ_MAXMSGSIZE
+#endif
+
 /* Most internal nxmq_* interfaces are not available in the user space in
  * PROTECTED and KERNEL builds.  In that context, the application message
  * queue interfaces must be used.  The differences between the two sets of
@@ -92,7 +101,7 @@ struct mqueue_inode_s
   int16_t nmsgs;              /* Number of message in the queue */
   int16_t nwaitnotfull;       /* Number tasks waiting for not full */
   int16_t nwaitnotempty;      /* Number tasks waiting for not empty */
-#if CONFIG_MQ_MAXMSGSIZE < 256
+#if MQ_MAX_MSGSIZE < 256
   uint8_t maxmsgsize;         /* Max size of message in message queue */
 #else
   uint16_t maxmsgsize;        /* Max size of message in message queue */
@@ -81,6 +81,10 @@ struct mtd_smart_procfs_data_s
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
   uint32_t            uneven_wearcount; /* Number of uneven block erases */
 #endif
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+  uint32_t            cachehits;        /* Sector map cache hits */
+  uint32_t            cachemisses;      /* Sector map cache misses */
+#endif
 };
 
 /* The following defines debug command data passed from the procfs layer to
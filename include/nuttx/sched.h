@@ -688,6 +688,10 @@ struct tcb_s
   uint32_t run_max;                      /* Max time thread run                 */
 #endif
 
+#ifdef CONFIG_SCHED_LATENCY
+  uint32_t ready_start;                  /* Time when thread was made ready     */
+#endif
+
   /* State save areas *******************************************************/
 
   /* The form and content of these fields are platform-specific.            */
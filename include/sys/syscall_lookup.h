@@ -263,6 +263,7 @@ SYSCALL_LOOKUP(lutimens,                   2)
 SYSCALL_LOOKUP(futimens,                   2)
 
 #if defined(CONFIG_FS_RAMMAP)
+  SYSCALL_LOOKUP(msync,                    3)
   SYSCALL_LOOKUP(munmap,                   2)
 #endif
 
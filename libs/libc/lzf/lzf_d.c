@@ -250,15 +250,35 @@ unsigned int lzf_decompress (FAR const void *const in_data,
                     memcpy (op, ref, len);
                     op += len;
                   }
+                else if (op == ref + 1)
+                  {
+                    /* A run of a single repeated octet */
+
+                    memset(op, *ref, len);
+                    op += len;
+                  }
                 else
                   {
-                    /* Overlapping, use octet by octet copying */
+                    /* Overlapping.  The output repeats with a period of
+                     * op - ref octets, so copy it in pieces that never
+                     * overlap.  Each piece makes the next one twice as
+                     * long.
+                     */
 
                     do
                       {
-                        *op++ = *ref++;
+                        unsigned int n = op - ref;
+
+                        if (n > len)
+                          {
+                            n = len;
+                          }
+
+                        memcpy(op, ref, n);
+                        op  += n;
+                        len -= n;
                       }
-                    while (--len);
+                    while (len > 0);
                   }
 
                 break;
@@ -24,8 +24,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,6 +54,34 @@ FAR void *memchr(FAR const void *s, int c, size_t n)
 
   if (s)
     {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      uintptr_t mask = LIBC_REPEAT(c);
+      uintptr_t word;
+
+      /* Check bytes up to the first word boundary */
+
+      for (; n > 0 && !LIBC_ALIGNED(p); n--, p++)
+        {
+          if (*p == (unsigned char)c)
+            {
+              return (FAR void *)p;
+            }
+        }
+
+      /* Then skip whole words that do not contain 'c':  XOR turns the
+       * matching bytes into zero bytes.
+       */
+
+      for (; n >= LIBC_WORDSIZE; n -= LIBC_WORDSIZE, p += LIBC_WORDSIZE)
+        {
+          word = *(FAR const uintptr_t *)p ^ mask;
+          if (LIBC_HASZERO(word))
+            {
+              break;
+            }
+        }
+#endif
+
       while (n--)
         {
           if (*p == (unsigned char)c)
@@ -24,8 +24,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -40,6 +43,41 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
   FAR unsigned char *pout = (FAR unsigned char *)dest;
   FAR unsigned char *pin  = (FAR unsigned char *)src;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Copy a word at a time if the source and destination can both be word
+   * aligned.
+   */
+
+  if (n >= 2 * LIBC_WORDSIZE && LIBC_SAMEALIGN(pout, pin))
+    {
+      while (!LIBC_ALIGNED(pout))
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      while (n >= 4 * LIBC_WORDSIZE)
+        {
+          ((FAR uintptr_t *)pout)[0] = ((FAR const uintptr_t *)pin)[0];
+          ((FAR uintptr_t *)pout)[1] = ((FAR const uintptr_t *)pin)[1];
+          ((FAR uintptr_t *)pout)[2] = ((FAR const uintptr_t *)pin)[2];
+          ((FAR uintptr_t *)pout)[3] = ((FAR const uintptr_t *)pin)[3];
+          pout += 4 * LIBC_WORDSIZE;
+          pin  += 4 * LIBC_WORDSIZE;
+          n    -= 4 * LIBC_WORDSIZE;
+        }
+
+      while (n >= LIBC_WORDSIZE)
+        {
+          *(FAR uintptr_t *)pout = *(FAR const uintptr_t *)pin;
+          pout += LIBC_WORDSIZE;
+          pin  += LIBC_WORDSIZE;
+          n    -= LIBC_WORDSIZE;
+        }
+    }
+#endif
+
   while (n-- > 0) *pout++ = *pin++;
   return dest;
 }
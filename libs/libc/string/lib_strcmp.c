@@ -24,8 +24,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "string/lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -35,6 +38,40 @@
 int strcmp(FAR const char *cs, FAR const char *ct)
 {
   register signed char result;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* If both strings have the same alignment, skip whole words that are
+   * equal and do not contain the terminating NUL.  The byte loop below
+   * then finds the difference.
+   */
+
+  if (LIBC_SAMEALIGN(cs, ct))
+    {
+      FAR const uintptr_t *ws;
+      FAR const uintptr_t *wt;
+
+      for (; !LIBC_ALIGNED(cs); cs++, ct++)
+        {
+          if ((result = *cs - *ct) != 0 || !*cs)
+            {
+              return result;
+            }
+        }
+
+      ws = (FAR const uintptr_t *)cs;
+      wt = (FAR const uintptr_t *)ct;
+
+      while (*ws == *wt && !LIBC_HASZERO(*ws))
+        {
+          ws++;
+          wt++;
+        }
+
+      cs = (FAR const char *)ws;
+      ct = (FAR const char *)wt;
+    }
+#endif
+
   for (; ; )
     {
       if ((result = *cs - *ct++) != 0 || !*cs++)
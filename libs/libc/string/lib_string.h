@@ -0,0 +1,70 @@
+/****************************************************************************
+ * libs/libc/string/lib_string.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_STRING_LIB_STRING_H
+#define __LIBS_LIBC_STRING_LIB_STRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Helpers for the word-at-a-time string functions selected with
+ * CONFIG_LIBC_STRING_OPTSPEED.  A "word" is the native pointer-sized
+ * integer.
+ *
+ * Word accesses are only made at word-aligned addresses, so reading a few
+ * bytes beyond the end of a string can never cross into another page or
+ * memory region.
+ */
+
+#define LIBC_WORDSIZE        sizeof(uintptr_t)
+#define LIBC_WORDMASK        (LIBC_WORDSIZE - 1)
+
+/* Is the address 'p' aligned to a word boundary? */
+
+#define LIBC_ALIGNED(p)      (((uintptr_t)(p) & LIBC_WORDMASK) == 0)
+
+/* Do two addresses have the same alignment within a word? */
+
+#define LIBC_SAMEALIGN(p, q) ((((uintptr_t)(p) ^ (uintptr_t)(q)) & \
+                              LIBC_WORDMASK) == 0)
+
+/* 0x0101...01 and 0x8080...80 in a word */
+
+#define LIBC_ONES            ((uintptr_t)-1 / 0xff)
+#define LIBC_HIGHS           (LIBC_ONES * 0x80)
+
+/* The byte 'c' replicated into every byte of a word */
+
+#define LIBC_REPEAT(c)       (LIBC_ONES * (uint8_t)(c))
+
+/* Non-zero if any byte of the word 'w' is zero */
+
+#define LIBC_HASZERO(w)      (((w) - LIBC_ONES) & ~(w) & LIBC_HIGHS)
+
+#endif /* __LIBS_LIBC_STRING_LIB_STRING_H */
@@ -58,6 +58,11 @@
 #define LOCAL_SYNC_BYTE   0x42     /* Byte in sync sequence */
 #define LOCAL_END_BYTE    0xbd     /* End of sync sequence */
 
+/* Size of the sync sequence and of the whole header sent with a packet */
+
+#define LOCAL_PREAMBLE_SIZE 8
+#define LOCAL_HEADER_SIZE   (LOCAL_PREAMBLE_SIZE + sizeof(uint16_t))
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
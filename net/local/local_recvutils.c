@@ -133,32 +133,69 @@ errout:
 
 int local_sync(FAR struct file *filep)
 {
+  uint8_t header[LOCAL_HEADER_SIZE];
   size_t readlen;
+  size_t navail;
   uint16_t pktlen;
   uint8_t sync;
+  bool insync;
   int ret;
+  int i;
 
-  /* Loop until a valid pre-amble is encountered:  SYNC bytes followed
-   * by one END byte.
+  /* The sender writes the whole header at once, so normally the header
+   * can be read with a single read:  The preamble ends with a SYNC byte
+   * followed by the END byte and then the packet length follows.
    */
 
-  do
+  readlen = LOCAL_HEADER_SIZE;
+  ret     = local_fifo_read(filep, header, &readlen, false);
+  if (ret < 0)
     {
-      /* Read until we encounter a sync byte */
+      nerr("ERROR: Failed to read packet header: %d\n", ret);
+      return ret;
+    }
 
-      do
+  if (header[LOCAL_PREAMBLE_SIZE - 2] == LOCAL_SYNC_BYTE &&
+      header[LOCAL_PREAMBLE_SIZE - 1] == LOCAL_END_BYTE)
+    {
+      memcpy(&pktlen, &header[LOCAL_PREAMBLE_SIZE], sizeof(uint16_t));
+      return pktlen;
+    }
+
+  /* The stream is out of sync.  A valid pre-amble is SYNC bytes followed
+   * by one END byte.  First look for it in the bytes that were just read:
+   * If the stream is only a few bytes off, the pre-amble of the next packet
+   * is already in the buffer.
+   *
+   * Only an END byte at or after the position where it ends a whole
+   * header is accepted.  An earlier one would mean that bytes of the
+   * packet itself have already been consumed with the header.
+   */
+
+  insync = false;
+  for (i = 0; i < LOCAL_HEADER_SIZE; i++)
+    {
+      if (insync && header[i] == LOCAL_END_BYTE &&
+          i >= LOCAL_PREAMBLE_SIZE - 1)
         {
-          readlen = sizeof(uint8_t);
-          ret     = local_fifo_read(filep, &sync, &readlen, false);
-          if (ret < 0)
-            {
-              nerr("ERROR: Failed to read sync bytes: %d\n", ret);
-              return ret;
-            }
+          break;
         }
-      while (sync != LOCAL_SYNC_BYTE);
 
-      /* Then read to the end of the SYNC sequence */
+      insync = (header[i] == LOCAL_SYNC_BYTE);
+    }
+
+  if (i < LOCAL_HEADER_SIZE)
+    {
+      /* Found.  Some of the packet length may follow in the buffer */
+
+      navail = LOCAL_HEADER_SIZE - 1 - i;
+      memcpy(&pktlen, &header[i + 1], navail);
+    }
+  else
+    {
+      /* Not found.  Continue the search one byte at a time, keeping track
+       * of whether the buffer ended within a run of SYNC bytes.
+       */
 
       do
         {
@@ -169,15 +206,28 @@ int local_sync(FAR struct file *filep)
               nerr("ERROR: Failed to read sync bytes: %d\n", ret);
               return ret;
             }
+
+          if (insync && sync == LOCAL_END_BYTE)
+            {
+              break;
+            }
+
+          insync = (sync == LOCAL_SYNC_BYTE);
         }
-      while (sync == LOCAL_SYNC_BYTE);
+      while (true);
+
+      navail = 0;
     }
-  while (sync != LOCAL_END_BYTE);
 
-  /* Then read the packet length */
+  /* Then read the rest of the packet length */
+
+  readlen = sizeof(uint16_t) - navail;
+  if (readlen > 0)
+    {
+      ret = local_fifo_read(filep, (FAR uint8_t *)&pktlen + navail,
+                            &readlen, false);
+    }
 
-  readlen = sizeof(uint16_t);
-  ret     = local_fifo_read(filep, (FAR uint8_t *)&pktlen, &readlen, false);
   return ret < 0 ? ret : pktlen;
 }
 
@@ -27,6 +27,7 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -38,12 +39,6 @@
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_LOCAL)
 
-/****************************************************************************
- * Pre-processor Definitions
- ****************************************************************************/
-
-#define LOCAL_PREAMBLE_SIZE 8
-
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -128,29 +123,26 @@ int local_send_packet(FAR struct file *filep, FAR const struct iovec *buf,
 {
   FAR const struct iovec *end = buf + len;
   FAR const struct iovec *iov;
+  uint8_t header[LOCAL_HEADER_SIZE];
   int ret = -EINVAL;
   uint16_t len16;
 
   if (preamble)
     {
-      /* Send the packet preamble */
-
-      ret = local_fifo_write(filep, g_preamble, LOCAL_PREAMBLE_SIZE);
-      if (ret != LOCAL_PREAMBLE_SIZE)
-        {
-          return ret;
-        }
-
-      /* Send the packet length */
+      /* Send the packet preamble and the packet length with a single write
+       * so that the receiver is woken up only once for the header.
+       */
 
       for (len16 = 0, iov = buf; iov != end; iov++)
         {
           len16 += iov->iov_len;
         }
 
-      ret = local_fifo_write(filep, (FAR const uint8_t *)&len16,
-                             sizeof(uint16_t));
-      if (ret != sizeof(uint16_t))
+      memcpy(header, g_preamble, LOCAL_PREAMBLE_SIZE);
+      memcpy(&header[LOCAL_PREAMBLE_SIZE], &len16, sizeof(uint16_t));
+
+      ret = local_fifo_write(filep, header, LOCAL_HEADER_SIZE);
+      if (ret != LOCAL_HEADER_SIZE)
         {
           return ret;
         }
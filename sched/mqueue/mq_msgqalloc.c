@@ -64,8 +64,8 @@ FAR struct mqueue_inode_s *nxmq_alloc_msgq(FAR struct mq_attr *attr)
    * larger than the configured maximum message size.
    */
 
-  DEBUGASSERT(!attr || attr->mq_msgsize <= MQ_MAX_BYTES);
-  if (attr && attr->mq_msgsize > MQ_MAX_BYTES)
+  DEBUGASSERT(!attr || attr->mq_msgsize <= MQ_MAX_MSGSIZE);
+  if (attr && attr->mq_msgsize > MQ_MAX_MSGSIZE)
     {
       return NULL;
     }
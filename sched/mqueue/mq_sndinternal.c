@@ -114,8 +114,12 @@ int nxmq_verify_send(FAR struct mqueue_inode_s *msgq, int oflags,
  *   the g_msgfreeirq list.  If this is unsuccessful, the calling interrupt
  *   handler will be notified.
  *
+ *   Messages larger than the pre-allocated payload (only possible with
+ *   CONFIG_MQ_MAXDYNMSGSIZE) are always allocated from the heap, sized to
+ *   the message, and never from the interrupt level.
+ *
  * Input Parameters:
- *   None
+ *   msglen - The length of the message payload in bytes
  *
  * Returned Value:
  *   A reference to the allocated msg structure.  On a failure to allocate,
@@ -123,11 +127,35 @@ int nxmq_verify_send(FAR struct mqueue_inode_s *msgq, int oflags,
  *
  ****************************************************************************/
 
-FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
+FAR struct mqueue_msg_s *nxmq_alloc_msg(size_t msglen)
 {
   FAR struct mqueue_msg_s *mqmsg;
   irqstate_t flags;
 
+#if MQ_MAX_MSGSIZE > MQ_MAX_BYTES
+  /* Does the message fit in a pre-allocated message structure? */
+
+  if (msglen > MQ_MAX_BYTES)
+    {
+      /* No.. allocate just enough space for this message.  The heap cannot
+       * be used from an interrupt handler.
+       */
+
+      if (up_interrupt_context())
+        {
+          return NULL;
+        }
+
+      mqmsg = (FAR struct mqueue_msg_s *)kmm_malloc(MQ_MSG_SIZE(msglen));
+      if (mqmsg != NULL)
+        {
+          mqmsg->type = MQ_ALLOC_DYN;
+        }
+
+      return mqmsg;
+    }
+#endif
+
   /* If we were called from an interrupt handler, then try to get the message
    * from generally available list of messages. If this fails, then try the
    * list of messages reserved for interrupt handlers
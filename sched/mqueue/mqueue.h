@@ -30,6 +30,7 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <stdbool.h>
 #include <limits.h>
 #include <mqueue.h>
@@ -47,6 +48,10 @@
 #define MQ_MAX_MSGS    16
 #define MQ_PRIO_MAX    _POSIX_MQ_PRIO_MAX
 
+/* Size of a message structure with a payload of 'n' bytes */
+
+#define MQ_MSG_SIZE(n) (offsetof(struct mqueue_msg_s, mail) + (n))
+
 /********************************************************************************
  * Public Type Definitions
  ********************************************************************************/
@@ -65,7 +70,7 @@ struct mqueue_msg_s
   FAR struct mqueue_msg_s *next;  /* Forward link to next message */
   uint8_t type;                   /* (Used to manage allocations) */
   uint8_t priority;               /* priority of message */
-#if MQ_MAX_BYTES < 256
+#if MQ_MAX_MSGSIZE < 256
   uint8_t msglen;                 /* Message data length */
 #else
   uint16_t msglen;                /* Message data length */
@@ -127,7 +132,7 @@ ssize_t nxmq_do_receive(FAR struct mqueue_inode_s *msgq,
 
 int nxmq_verify_send(FAR struct mqueue_inode_s *msgq, int oflags,
                      FAR const char *msg, size_t msglen, unsigned int prio);
-FAR struct mqueue_msg_s *nxmq_alloc_msg(void);
+FAR struct mqueue_msg_s *nxmq_alloc_msg(size_t msglen);
 int nxmq_wait_send(FAR struct mqueue_inode_s *msgq, int oflags);
 int nxmq_do_send(FAR struct mqueue_inode_s *msgq,
                  FAR struct mqueue_msg_s *mqmsg,
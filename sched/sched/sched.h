@@ -418,6 +418,12 @@ int  nxsched_pause_cpu(FAR struct tcb_s *tcb);
 void weak_function nxsched_process_cpuload(void);
 #endif
 
+#ifdef CONFIG_SCHED_PROFILE
+/* Sampling profiler support */
+
+void nxsched_process_profile(void);
+#endif
+
 /* Critical section monitor */
 
 #ifdef CONFIG_SCHED_CRITMONITOR
@@ -427,6 +433,12 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb);
 void nxsched_suspend_critmon(FAR struct tcb_s *tcb);
 #endif
 
+/* Scheduling latency statistics */
+
+#ifdef CONFIG_SCHED_LATENCY
+void nxsched_resume_latency(FAR struct tcb_s *tcb);
+#endif
+
 /* TCB operations */
 
 bool nxsched_verify_tcb(FAR struct tcb_s *tcb);
@@ -179,6 +179,12 @@ void weak_function nxsched_process_cpuload(void)
 
 #endif
 
+#ifdef CONFIG_SCHED_PROFILE
+  /* Take a profiler sample of the thread running on this CPU */
+
+  nxsched_process_profile();
+#endif
+
   /* If the accumulated tick value exceed a time constant, then shift the
    * accumulators and recalculate the total.
    */
@@ -0,0 +1,459 @@
+/****************************************************************************
+ * sched/sched/sched_latency.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/stat.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_LATENCY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Latencies are collected separately for each band of 32 priorities */
+
+#define LATENCY_NBANDS      ((SCHED_PRIORITY_MAX >> 5) + 1)
+
+/* Histogram bucket n counts latencies below (1 << n) microseconds; the
+ * last bucket counts everything else.
+ */
+
+#define LATENCY_NBUCKETS    20
+
+/* Output format:
+ *
+ *            1111111111222222222233333333334444444444555555
+ *   1234567890123456789012345678901234567890123456789012345
+ *
+ *   PRIO         COUNT      MIN      AVG      MAX      P99
+ *   DDD-DDD DDDDDDDDDD DDDDDDDD DDDDDDDD DDDDDDDD DDDDDDDD
+ *
+ * All times are in microseconds.  P99 is the upper bound of the histogram
+ * bucket holding the 99th percentile.
+ */
+
+#define HDR_FMT "PRIO         COUNT      MIN      AVG      MAX      P99\n"
+#define LAT_FMT "%3u-%-3u %10lu %8lu %8lu %8lu %8lu\n"
+
+#define LATENCY_LINELEN     64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure holds the statistics of one priority band */
+
+struct latency_band_s
+{
+  uint32_t count;                       /* Number of samples */
+  uint32_t min;                         /* Minimum latency (usec) */
+  uint32_t max;                         /* Maximum latency (usec) */
+  uint64_t sum;                         /* Sum of all latencies (usec) */
+  uint32_t hist[LATENCY_NBUCKETS];      /* log2 histogram */
+};
+
+/* This structure describes one open "file" */
+
+struct latency_file_s
+{
+  struct procfs_file_s base;                  /* Base open file structure */
+  struct latency_band_s snap[LATENCY_NBANDS]; /* Snapshot of g_latency */
+  char line[LATENCY_LINELEN];                 /* Buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     latency_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     latency_close(FAR struct file *filep);
+static ssize_t latency_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t latency_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+static int     latency_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     latency_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct latency_band_s g_latency[LATENCY_NBANDS];
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly extern'ed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations latency_operations =
+{
+  latency_open,       /* open */
+  latency_close,      /* close */
+  latency_read,       /* read */
+  latency_write,      /* write */
+
+  latency_dup,        /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  latency_stat        /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: latency_percentile
+ *
+ * Description:
+ *   Return the upper bound, in microseconds, of the histogram bucket that
+ *   holds the 99th percentile of the band.
+ *
+ ****************************************************************************/
+
+static uint32_t latency_percentile(FAR const struct latency_band_s *band)
+{
+  uint32_t threshold;
+  uint32_t total = 0;
+  int i;
+
+  /* Number of samples that must lie at or below the percentile */
+
+  threshold = band->count - band->count / 100;
+
+  for (i = 0; i < LATENCY_NBUCKETS - 1; i++)
+    {
+      total += band->hist[i];
+      if (total >= threshold)
+        {
+          return (uint32_t)1 << i;
+        }
+    }
+
+  return band->max;
+}
+
+/****************************************************************************
+ * Name: latency_open
+ ****************************************************************************/
+
+static int latency_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct latency_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* "latency" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "latency") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct latency_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_close
+ ****************************************************************************/
+
+static int latency_close(FAR struct file *filep)
+{
+  FAR struct latency_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct latency_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_read
+ ****************************************************************************/
+
+static ssize_t latency_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct latency_file_s *attr;
+  FAR struct latency_band_s *band;
+  irqstate_t flags;
+  size_t linesize;
+  size_t ncopied;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct latency_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* If f_pos is zero, then take a snapshot of the statistics so that the
+   * output stays consistent if the user reads the file in several pieces.
+   */
+
+  if (filep->f_pos == 0)
+    {
+      flags = enter_critical_section();
+      memcpy(attr->snap, g_latency, sizeof(g_latency));
+      leave_critical_section(flags);
+    }
+
+  offset   = filep->f_pos;
+
+  /* The first line to output is the header */
+
+  linesize = snprintf(attr->line, LATENCY_LINELEN, HDR_FMT);
+  ncopied  = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  /* Then one line for each priority band that has samples */
+
+  for (i = 0; i < LATENCY_NBANDS && ncopied < buflen; i++)
+    {
+      band = &attr->snap[i];
+      if (band->count == 0)
+        {
+          continue;
+        }
+
+      linesize = snprintf(attr->line, LATENCY_LINELEN, LAT_FMT,
+                          i << 5, (i << 5) + 31,
+                          (unsigned long)band->count,
+                          (unsigned long)band->min,
+                          (unsigned long)(band->sum / band->count),
+                          (unsigned long)band->max,
+                          (unsigned long)latency_percentile(band));
+
+      ncopied += procfs_memcpy(attr->line, linesize, buffer + ncopied,
+                               buflen - ncopied, &offset);
+    }
+
+  filep->f_pos += ncopied;
+  return ncopied;
+}
+
+/****************************************************************************
+ * Name: latency_write
+ *
+ * Description:
+ *   Any write to the file discards all statistics collected so far.
+ *
+ ****************************************************************************/
+
+static ssize_t latency_write(FAR struct file *filep, FAR const char *buffer,
+                             size_t buflen)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  memset(g_latency, 0, sizeof(g_latency));
+  leave_critical_section(flags);
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: latency_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int latency_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct latency_file_s *oldattr;
+  FAR struct latency_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct latency_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct latency_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct latency_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int latency_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "latency" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "latency") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "latency" is the name for a read-write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_resume_latency
+ *
+ * Description:
+ *   Called when a thread resumes execution.  If the thread was made ready
+ *   to run since it last ran, account the time it spent waiting for the
+ *   CPU in the statistics of its priority band.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is resuming.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Might be called from an interrupt handler
+ *
+ ****************************************************************************/
+
+void nxsched_resume_latency(FAR struct tcb_s *tcb)
+{
+  FAR struct latency_band_s *band;
+  struct timespec ts;
+  uint32_t usec;
+  int i;
+
+  /* Zero means that the thread was not made ready (or that the timer was
+   * not yet running when it was).
+   */
+
+  if (tcb->ready_start == 0)
+    {
+      return;
+    }
+
+  up_critmon_convert(up_critmon_gettime() - tcb->ready_start, &ts);
+  tcb->ready_start = 0;
+
+  usec = (uint32_t)ts.tv_sec * 1000000 + (uint32_t)ts.tv_nsec / 1000;
+
+  band = &g_latency[tcb->sched_priority >> 5];
+  if (band->count == 0 || usec < band->min)
+    {
+      band->min = usec;
+    }
+
+  if (usec > band->max)
+    {
+      band->max = usec;
+    }
+
+  band->count++;
+  band->sum += usec;
+
+  /* Find the histogram bucket:  The smallest power of two above usec */
+
+  i = 0;
+  while (i < LATENCY_NBUCKETS - 1 && (usec >> i) != 0)
+    {
+      i++;
+    }
+
+  band->hist[i]++;
+}
+
+#endif /* CONFIG_SCHED_LATENCY */
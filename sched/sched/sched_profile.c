@@ -0,0 +1,518 @@
+/****************************************************************************
+ * sched/sched/sched_profile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/stat.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PROFILE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format (one line per sampled stack, root first, as expected by
+ * flamegraph.pl and similar tools):
+ *
+ *   <task name or pid>;<address>;...;<address> <sample count>
+ *
+ * Samples that did not fit into the table are reported on a final
+ * "[dropped] <count>" line.
+ *
+ * Addresses are printed in hexadecimal and may be symbolized on the host
+ * with addr2line.  When the sample is taken in an interrupt handler, the
+ * stack is unwound from the interrupted context so that the frames of the
+ * timer interrupt itself are not recorded.
+ */
+
+#define PROFILE_LINELEN  (CONFIG_TASK_NAME_SIZE + 24 + \
+                          19 * CONFIG_SCHED_PROFILE_DEPTH)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one sampled stack */
+
+struct profile_stack_s
+{
+  pid_t pid;                                   /* Sampled thread */
+  uint8_t depth;                               /* Number of frames */
+  uint32_t count;                              /* Number of samples */
+  FAR void *frames[CONFIG_SCHED_PROFILE_DEPTH]; /* Leaf first */
+};
+
+/* This structure describes one open "file" */
+
+struct profile_file_s
+{
+  struct procfs_file_s base;        /* Base open file structure */
+  FAR struct profile_stack_s *snap; /* Snapshot of the sample table */
+  uint32_t dropped;                 /* Snapshot of g_profile_dropped */
+  char line[PROFILE_LINELEN];       /* Buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     profile_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     profile_close(FAR struct file *filep);
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static ssize_t profile_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+static int     profile_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     profile_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The table of sampled stacks, indexed by a hash of the stack */
+
+static struct profile_stack_s g_profile[CONFIG_SCHED_PROFILE_NSTACKS];
+
+/* Number of samples lost because the table was full */
+
+static uint32_t g_profile_dropped;
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly extern'ed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations profile_operations =
+{
+  profile_open,       /* open */
+  profile_close,      /* close */
+  profile_read,       /* read */
+  profile_write,      /* write */
+
+  profile_dup,        /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  profile_stat        /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_hash
+ *
+ * Description:
+ *   Return the FNV-1a hash of a sampled stack.
+ *
+ ****************************************************************************/
+
+static uint32_t profile_hash(pid_t pid, FAR void **frames, int depth)
+{
+  uint32_t hash = 2166136261u;
+  int i;
+
+  hash = (hash ^ (uint32_t)pid) * 16777619u;
+  for (i = 0; i < depth; i++)
+    {
+      hash = (hash ^ (uint32_t)(uintptr_t)frames[i]) * 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: profile_taskname
+ ****************************************************************************/
+
+static void profile_taskname(pid_t pid, FAR char *name, size_t size)
+{
+#if CONFIG_TASK_NAME_SIZE > 0
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  tcb   = nxsched_get_tcb(pid);
+  if (tcb != NULL)
+    {
+      strlcpy(name, tcb->name, size);
+      leave_critical_section(flags);
+      return;
+    }
+
+  leave_critical_section(flags);
+#endif
+
+  snprintf(name, size, "%d", (int)pid);
+}
+
+/****************************************************************************
+ * Name: profile_open
+ ****************************************************************************/
+
+static int profile_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct profile_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* "profile" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "profile") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct profile_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_close
+ ****************************************************************************/
+
+static int profile_close(FAR struct file *filep)
+{
+  FAR struct profile_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct profile_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the snapshot and the file attributes structure */
+
+  if (attr->snap != NULL)
+    {
+      kmm_free(attr->snap);
+    }
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_read
+ ****************************************************************************/
+
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct profile_file_s *attr;
+  FAR struct profile_stack_s *stack;
+  irqstate_t flags;
+  size_t linesize;
+  size_t copysize;
+  size_t ncopied;
+  off_t offset;
+  int i;
+  int j;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct profile_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* If f_pos is zero, then take a snapshot of the sample table.  The
+   * snapshot is kept so that the output stays stable if the user reads
+   * the file in several pieces.
+   */
+
+  if (filep->f_pos == 0)
+    {
+      if (attr->snap == NULL)
+        {
+          attr->snap = kmm_malloc(sizeof(g_profile));
+          if (attr->snap == NULL)
+            {
+              return -ENOMEM;
+            }
+        }
+
+      flags = enter_critical_section();
+      memcpy(attr->snap, g_profile, sizeof(g_profile));
+      attr->dropped = g_profile_dropped;
+      leave_critical_section(flags);
+    }
+  else if (attr->snap == NULL)
+    {
+      return 0;
+    }
+
+  offset  = filep->f_pos;
+  ncopied = 0;
+
+  for (i = 0; i < CONFIG_SCHED_PROFILE_NSTACKS && ncopied < buflen; i++)
+    {
+      stack = &attr->snap[i];
+      if (stack->count == 0)
+        {
+          continue;
+        }
+
+      /* Task name first, then the frames from the root to the leaf */
+
+      profile_taskname(stack->pid, attr->line, CONFIG_TASK_NAME_SIZE + 12);
+      linesize = strlen(attr->line);
+
+      for (j = stack->depth - 1; j >= 0; j--)
+        {
+          linesize += snprintf(&attr->line[linesize],
+                               PROFILE_LINELEN - linesize, ";%p",
+                               stack->frames[j]);
+        }
+
+      linesize += snprintf(&attr->line[linesize], PROFILE_LINELEN - linesize,
+                           " %lu\n", (unsigned long)stack->count);
+
+      copysize = procfs_memcpy(attr->line, linesize, buffer + ncopied,
+                               buflen - ncopied, &offset);
+      ncopied += copysize;
+    }
+
+  if (attr->dropped > 0 && ncopied < buflen)
+    {
+      linesize = snprintf(attr->line, PROFILE_LINELEN, "[dropped] %lu\n",
+                          (unsigned long)attr->dropped);
+      ncopied += procfs_memcpy(attr->line, linesize, buffer + ncopied,
+                               buflen - ncopied, &offset);
+    }
+
+  filep->f_pos += ncopied;
+  return ncopied;
+}
+
+/****************************************************************************
+ * Name: profile_write
+ *
+ * Description:
+ *   Any write to the file discards all samples collected so far.
+ *
+ ****************************************************************************/
+
+static ssize_t profile_write(FAR struct file *filep, FAR const char *buffer,
+                             size_t buflen)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  memset(g_profile, 0, sizeof(g_profile));
+  g_profile_dropped = 0;
+  leave_critical_section(flags);
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: profile_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int profile_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct profile_file_s *oldattr;
+  FAR struct profile_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct profile_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_zalloc(sizeof(struct profile_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The snapshot is not shared; the new file takes its own on the next
+   * read from offset zero.
+   */
+
+  memcpy(newattr, oldattr, sizeof(struct profile_file_s));
+  newattr->snap = NULL;
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: profile_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int profile_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "profile" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "profile") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "profile" is the name for a read-write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_process_profile
+ *
+ * Description:
+ *   Take one profiler sample:  Capture the stack of the running thread and
+ *   count it in the sample table.  This is called at the CPU load sampling
+ *   rate.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions/Limitations:
+ *   This function is normally called from a timer interrupt handler with
+ *   all interrupts disabled.
+ *
+ ****************************************************************************/
+
+void nxsched_process_profile(void)
+{
+  FAR void *frames[CONFIG_SCHED_PROFILE_DEPTH];
+  FAR struct profile_stack_s *stack;
+  FAR struct tcb_s *rtcb = this_task();
+  uint32_t hash;
+  int depth;
+  int i;
+
+  /* Unwind the interrupted thread, not the interrupt handler that is
+   * taking the sample.  Without an interrupt (as when the simulation drives
+   * the timer from its IDLE loop), the running thread is sampled in place.
+   */
+
+  if (up_interrupt_context())
+    {
+      depth = up_interrupted_backtrace(frames, CONFIG_SCHED_PROFILE_DEPTH);
+    }
+  else
+    {
+      depth = up_backtrace(rtcb, frames, CONFIG_SCHED_PROFILE_DEPTH);
+    }
+
+  if (depth < 0)
+    {
+      depth = 0;
+    }
+
+  /* Find the stack in the table, or an empty slot to hold it.  The table
+   * uses open addressing with linear probing.
+   */
+
+  hash = profile_hash(rtcb->pid, frames, depth);
+  for (i = 0; i < CONFIG_SCHED_PROFILE_NSTACKS; i++)
+    {
+      stack = &g_profile[(hash + i) % CONFIG_SCHED_PROFILE_NSTACKS];
+      if (stack->count == 0)
+        {
+          stack->pid   = rtcb->pid;
+          stack->depth = depth;
+          memcpy(stack->frames, frames, depth * sizeof(FAR void *));
+          stack->count = 1;
+          return;
+        }
+
+      if (stack->pid == rtcb->pid && stack->depth == depth &&
+          memcmp(stack->frames, frames, depth * sizeof(FAR void *)) == 0)
+        {
+          stack->count++;
+          return;
+        }
+    }
+
+  /* The table is full */
+
+  g_profile_dropped++;
+}
+
+#endif /* CONFIG_SCHED_PROFILE */
@@ -128,15 +128,31 @@ static FAR struct semholder_s *nxsem_findholder(sem_t *sem,
   FAR struct semholder_s *pholder;
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
+  FAR struct semholder_s *prev;
+
   /* Try to find the holder in the list of holders associated with this
    * semaphore
    */
 
-  for (pholder = sem->hhead; pholder != NULL; pholder = pholder->flink)
+  for (prev = NULL, pholder = sem->hhead;
+       pholder != NULL;
+       prev = pholder, pholder = pholder->flink)
     {
       if (pholder->htcb == htcb)
         {
-          /* Got it! */
+          /* Got it!  Move the holder to the head of the list.  The thread
+           * that just took a count is nearly always the next one to look
+           * itself up (to release the count, then to free the container),
+           * so this keeps those lookups and the unlink in
+           * nxsem_freeholder() O(1) even when many threads hold counts.
+           */
+
+          if (prev != NULL)
+            {
+              prev->flink    = pholder->flink;
+              pholder->flink = sem->hhead;
+              sem->hhead     = pholder;
+            }
 
           return pholder;
         }
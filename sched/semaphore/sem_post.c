@@ -112,6 +112,21 @@ int nxsem_post(FAR sem_t *sem)
       nxsem_release_holder(sem);
       sem->semcount++;
 
+      /* If the resulting count is positive, then no task was waiting for
+       * the semaphore and none can be unblocked, so there is nothing to
+       * protect with sched_lock().  Priority restoration is still
+       * performed in this case.
+       */
+
+      if (sem->semcount > 0)
+        {
+#ifdef CONFIG_PRIORITY_INHERITANCE
+          nxsem_restore_baseprio(NULL, sem);
+#endif
+          leave_critical_section(flags);
+          return OK;
+        }
+
 #ifdef CONFIG_PRIORITY_INHERITANCE
       /* Don't let any unblocked tasks run until we complete any priority
        * restoration steps.  Interrupts are disabled, but we do not want
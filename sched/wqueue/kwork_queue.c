@@ -70,6 +70,63 @@ static void lp_work_timer_expiry(wdparm_t arg)
 }
 #endif
 
+/****************************************************************************
+ * Name: work_qqueue
+ *
+ * Description:
+ *   Queue work on the selected work queue.  Any pending instance of the
+ *   work is removed in the same critical section in which the work is
+ *   re-queued, so that re-arming work from an interrupt handler costs a
+ *   single critical section.
+ *
+ ****************************************************************************/
+
+static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
+                        FAR struct work_s *work, worker_t worker,
+                        FAR void *arg, clock_t delay, wdentry_t expiry)
+{
+  irqstate_t flags;
+
+  /* Interrupts are disabled so that this logic can be called from with
+   * task logic or from interrupt handling logic.
+   */
+
+  flags = enter_critical_section();
+
+  /* Remove the entry from the timer and work queue. */
+
+  if (work->worker != NULL)
+    {
+      if (WDOG_ISACTIVE(&work->u.timer))
+        {
+          wd_cancel(&work->u.timer);
+        }
+      else
+        {
+          sq_rem((FAR sq_entry_t *)work, &wqueue->q);
+        }
+    }
+
+  /* Initialize the work structure. */
+
+  work->worker = worker;           /* Work callback. non-NULL means queued */
+  work->arg = arg;                 /* Callback argument */
+
+  /* Queue the new work */
+
+  if (!delay)
+    {
+      sq_addlast((FAR sq_entry_t *)work, &wqueue->q);
+      nxsem_post(&wqueue->sem);
+    }
+  else
+    {
+      wd_start(&work->u.timer, delay, expiry, (wdparm_t)work);
+    }
+
+  leave_critical_section(flags);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -107,40 +164,13 @@ static void lp_work_timer_expiry(wdparm_t arg)
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay)
 {
-  irqstate_t flags;
-
-  /* Remove the entry from the timer and work queue. */
-
-  work_cancel(qid, work);
-
-  /* Interrupts are disabled so that this logic can be called from with
-   * task logic or from interrupt handling logic.
-   */
-
-  flags = enter_critical_section();
-
-  /* Initialize the work structure. */
-
-  work->worker = worker;           /* Work callback. non-NULL means queued */
-  work->arg = arg;                 /* Callback argument */
-
-  /* Queue the new work */
-
 #ifdef CONFIG_SCHED_HPWORK
   if (qid == HPWORK)
     {
       /* Queue high priority work */
 
-      if (!delay)
-        {
-          sq_addlast((FAR sq_entry_t *)work, &g_hpwork.q);
-          nxsem_post(&g_hpwork.sem);
-        }
-      else
-        {
-          wd_start(&work->u.timer, delay, hp_work_timer_expiry,
-                   (wdparm_t)work);
-        }
+      work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker,
+                  arg, delay, hp_work_timer_expiry);
     }
   else
 #endif
@@ -149,20 +179,14 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     {
       /* Queue low priority work */
 
-      if (!delay)
-        {
-          sq_addlast((FAR sq_entry_t *)work, &g_lpwork.q);
-          nxsem_post(&g_lpwork.sem);
-        }
-      else
-        {
-          wd_start(&work->u.timer, delay, lp_work_timer_expiry,
-                   (wdparm_t)work);
-        }
+      work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work, worker,
+                  arg, delay, lp_work_timer_expiry);
     }
+  else
 #endif
-
-  leave_critical_section(flags);
+    {
+      return -EINVAL;
+    }
 
   return OK;
 }
@@ -43,6 +43,12 @@
  * Private Types
  ****************************************************************************/
 
+struct symbol_s
+{
+  char *name;                   /* Symbol name */
+  char *cond;                   /* Conditional compilation (may be NULL) */
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -50,6 +56,10 @@
 static const char *g_hdrfiles[MAX_HEADER_FILES];
 static int nhdrfiles;
 
+static struct symbol_s *g_symbols;
+static int nsymbols_alloc;
+static int nsymbols_found;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -116,6 +126,34 @@ static void add_hdrfile(const char *hdrfile)
     }
 }
 
+static void add_symbol(const char *name, const char *cond)
+{
+  if (nsymbols_found >= nsymbols_alloc)
+    {
+      nsymbols_alloc = nsymbols_alloc ? 2 * nsymbols_alloc : 256;
+      g_symbols = realloc(g_symbols,
+                          nsymbols_alloc * sizeof(struct symbol_s));
+      if (!g_symbols)
+        {
+          fprintf(stderr, "ERROR:  Out of memory\n");
+          exit(EXIT_FAILURE);
+        }
+    }
+
+  g_symbols[nsymbols_found].name = strdup(name);
+  g_symbols[nsymbols_found].cond =
+    cond && strlen(cond) > 0 ? strdup(cond) : NULL;
+  nsymbols_found++;
+}
+
+static int compare_symbols(const void *a, const void *b)
+{
+  const struct symbol_s *syma = a;
+  const struct symbol_s *symb = b;
+
+  return strcmp(syma->name, symb->name);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -217,7 +255,9 @@ int main(int argc, char **argv, char **envp)
       exit(EXIT_FAILURE);
     }
 
-  /* Get all of the header files that we need to include */
+  /* Get all of the header files that we need to include and all of the
+   * symbols.
+   */
 
   while ((ptr = read_line(instream)) != NULL)
     {
@@ -233,11 +273,22 @@ int main(int argc, char **argv, char **envp)
       /* Add the header file to the list of header files we need to include */
 
       add_hdrfile(g_parm[HEADER_INDEX]);
+
+      /* Add the symbol to the list of symbols to output */
+
+      add_symbol(g_parm[NAME_INDEX], g_parm[COND_INDEX]);
     }
 
-  /* Back to the beginning */
+  /* Output the symbols ordered by name so that the symbol table can be
+   * searched with a binary search (CONFIG_SYMTAB_ORDEREDBYNAME).
+   * Conditionally excluded entries do not affect the ordering.
+   */
 
-  rewind(instream);
+  if (nsymbols_found > 0)
+    {
+      qsort(g_symbols, nsymbols_found, sizeof(struct symbol_s),
+            compare_symbols);
+    }
 
   /* Output up-front file boilerplate */
 
@@ -259,35 +310,26 @@ int main(int argc, char **argv, char **envp)
   fprintf(outstream, "\nconst struct symtab_s %s[] =\n", symtab);
   fprintf(outstream, "{\n");
 
-  /* Parse each line in the CVS file */
+  /* Output each symbol */
 
   nextterm  = "";
   finalterm = "";
 
-  while ((ptr = read_line(instream)) != NULL)
+  for (i = 0; i < nsymbols_found; i++)
     {
-      /* Parse the line from the CVS file */
-
-      int nargs = parse_csvline(ptr);
-      if (nargs < PARM1_INDEX)
-        {
-          fprintf(stderr, "Only %d arguments found: %s\n", nargs, g_line);
-          exit(EXIT_FAILURE);
-        }
-
       /* Output any conditional compilation */
 
-      cond = (g_parm[COND_INDEX] && strlen(g_parm[COND_INDEX]) > 0);
+      cond = (g_symbols[i].cond != NULL);
       if (cond)
         {
-          fprintf(outstream, "%s#if %s\n", nextterm, g_parm[COND_INDEX]);
+          fprintf(outstream, "%s#if %s\n", nextterm, g_symbols[i].cond);
           nextterm  = "";
         }
 
       /* Output the symbol table entry */
 
       fprintf(outstream, "%s  { \"%s\", (FAR const void *)%s }",
-              nextterm, g_parm[NAME_INDEX], g_parm[NAME_INDEX]);
+              nextterm, g_symbols[i].name, g_symbols[i].name);
 
       if (cond)
         {